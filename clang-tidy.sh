@@ -95,6 +95,8 @@ vme/src/dilrun.cpp
 vme/src/dilrun.h
 vme/src/dilshare.cpp
 vme/src/dilshare.h
+vme/src/dilstring.cpp
+vme/src/dilstring.h
 vme/src/dilsup.cpp
 vme/src/dilsup.h
 vme/src/eliza.cpp
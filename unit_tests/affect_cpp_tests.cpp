@@ -0,0 +1,157 @@
+#define BOOST_TEST_MODULE "affect Unit Tests"
+#include "affect.h"
+
+#include "FixtureBase.h"
+#include "destruct.h"
+#include "event.h"
+#include "main_functions.h"
+#include "unit_data.h"
+#include "utils.h"
+
+#include <boost/test/unit_test.hpp>
+
+/**
+ * Affects without apply or tick functions, so only the beat and the
+ * duration matter.
+ */
+struct AffectFixture : public unit_tests::FixtureBase
+{
+    AffectFixture()
+        : FixtureBase()
+    {
+        unit = new_unit_data(UNIT_ST_OBJ, nullptr);
+    }
+
+    ~AffectFixture() override
+    {
+        // Let the cancelled events drain before the unit goes away
+        stop_affect(unit);
+        run(4 * WAIT_SEC);
+        delete unit;
+    }
+
+    void add(sbit16 id, ubit16 beat, sbit16 duration)
+    {
+        unit_affected_type af;
+        af.setID(id);
+        af.setBeat(beat);
+        af.setDuration(duration);
+        af.setFirstFI(-1);
+        af.setTickFI(-1);
+        af.setLastFI(-1);
+        af.setApplyFI(-1);
+        create_affect(unit, &af);
+    }
+
+    /// Advance the game clock the way the game loop does
+    void run(int tics)
+    {
+        for (int i = 0; i < tics; i++)
+        {
+            g_tics++;
+            g_events.process();
+            clear_destructed();
+        }
+    }
+
+    unit_data *unit;
+};
+
+BOOST_FIXTURE_TEST_SUITE(affect_cpp_tests, AffectFixture)
+
+BOOST_AUTO_TEST_CASE(shared_beat_event_test)
+{
+    int events = g_events.Count();
+
+    for (int i = 0; i < 20; i++)
+    {
+        add(1, WAIT_SEC, 10);
+    }
+    add(2, 2 * WAIT_SEC, 10);
+    add(3, 2 * WAIT_SEC, 10);
+
+    // One event per beat period, not per affect
+    BOOST_TEST(g_events.Count() == events + 2);
+
+    // Cancelled events are dropped when they come up
+    stop_affect(unit);
+    run(2 * WAIT_SEC);
+    BOOST_TEST(g_events.Count() == events);
+
+    start_affect(unit);
+    BOOST_TEST(g_events.Count() == events + 2);
+}
+
+BOOST_AUTO_TEST_CASE(duration_test)
+{
+    // The duration is decremented on each beat, the affect ends on the beat after it reaches zero
+    add(1, WAIT_SEC, 3);
+    run(4 * WAIT_SEC - 1);
+    BOOST_TEST(affected_by_spell(unit, 1) != nullptr);
+    BOOST_TEST(affected_by_spell(unit, 1)->getDuration() == 0);
+    run(1);
+    BOOST_TEST(affected_by_spell(unit, 1) == nullptr);
+    run(1);
+    BOOST_TEST(unit->getUnitAffected() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(late_join_test)
+{
+    int events = g_events.Count();
+
+    add(1, WAIT_SEC, 5);
+    run(1);
+
+    // Joins the running beat, but ticks a full beat after it was added
+    add(2, WAIT_SEC, 2);
+    BOOST_TEST(affected_by_spell(unit, 2)->getEventQueueElement() == affected_by_spell(unit, 1)->getEventQueueElement());
+    BOOST_TEST(g_events.Count() == events + 1);
+
+    run(WAIT_SEC - 1);
+    BOOST_TEST(affected_by_spell(unit, 1)->getDuration() == 4);
+    BOOST_TEST(affected_by_spell(unit, 2)->getDuration() == 2);
+
+    run(1);
+    BOOST_TEST(affected_by_spell(unit, 1)->getDuration() == 4);
+    BOOST_TEST(affected_by_spell(unit, 2)->getDuration() == 1);
+
+    run(WAIT_SEC - 1);
+    BOOST_TEST(affected_by_spell(unit, 1)->getDuration() == 3);
+    BOOST_TEST(affected_by_spell(unit, 2)->getDuration() == 1);
+
+    run(1);
+    BOOST_TEST(affected_by_spell(unit, 2)->getDuration() == 0);
+
+    // Ends three beats after it was added, as it would on a beat of its own
+    run(WAIT_SEC - 1);
+    BOOST_TEST(affected_by_spell(unit, 2) != nullptr);
+    run(1);
+    BOOST_TEST(affected_by_spell(unit, 2) == nullptr);
+    BOOST_TEST(affected_by_spell(unit, 1)->getDuration() == 2);
+
+    // Still one event for the beat
+    BOOST_TEST(g_events.Count() == events + 1);
+}
+
+BOOST_AUTO_TEST_CASE(changed_beat_test)
+{
+    int events = g_events.Count();
+
+    add(1, WAIT_SEC, 10);
+    add(2, WAIT_SEC, 10);
+    affected_by_spell(unit, 2)->setBeat(3 * WAIT_SEC);
+    run(WAIT_SEC);
+
+    // Moved to a beat of its own on the next beat
+    BOOST_TEST(g_events.Count() == events + 2);
+    BOOST_TEST(affected_by_spell(unit, 2)->getDuration() == 10);
+
+    run(3 * WAIT_SEC);
+    BOOST_TEST(affected_by_spell(unit, 2)->getDuration() == 9);
+
+    destroy_affect(affected_by_spell(unit, 2));
+    run(3 * WAIT_SEC);
+    BOOST_TEST(g_events.Count() == events + 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
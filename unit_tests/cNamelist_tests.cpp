@@ -1,6 +1,8 @@
 #define BOOST_TEST_MODULE "cNamelists Unit Tests"
 #include "namelist.h"
 
+#include "textutil.h"
+
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
@@ -300,6 +302,69 @@ BOOST_AUTO_TEST_CASE(ReadBuffer5_test)
     BOOST_TEST(list.Length() == 0);
 }
 
+BOOST_AUTO_TEST_CASE(ReadBuffer6_test)
+{
+    cNamelist list;
+    list.AppendName("Odin");
+    CByteBuffer buf;
+    buf.Append32(2);
+    buf.AppendString("Heimdall");
+    buf.AppendString("");
+    ////////////////////////// Test Subject //////////////////////////////
+    auto ret = list.ReadBuffer(&buf, 4387);
+    ////////////////////////// Test Subject //////////////////////////////
+    BOOST_TEST(ret == 0);
+    BOOST_TEST(list.Length() == 3);
+    BOOST_TEST(buf.GetReadPosition() == buf.GetLength());
+
+    {
+        std::string expected = R"("namelist": ["Odin","Heimdall",""])";
+        auto ret = list.json();
+        BOOST_TEST(ret == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ReadBuffer7_test)
+{
+    cNamelist list;
+    CByteBuffer buf;
+    buf.Append32(1000000);
+    buf.AppendString("Heimdall");
+    ////////////////////////// Test Subject //////////////////////////////
+    auto ret = list.ReadBuffer(&buf, 4387);
+    ////////////////////////// Test Subject //////////////////////////////
+    BOOST_TEST(ret == 1);
+    BOOST_TEST(list.Length() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(ReadNames_test)
+{
+    char **names = nullptr;
+    CByteBuffer buf;
+    buf.Append32(3);
+    buf.AppendString("Heimdall");
+    buf.AppendString("Tyr");
+    buf.AppendString("Loki");
+    ////////////////////////// Test Subject //////////////////////////////
+    auto ret = buf.ReadNames(&names, 0);
+    ////////////////////////// Test Subject //////////////////////////////
+    BOOST_TEST(ret == 0);
+    BOOST_REQUIRE(names != nullptr);
+    BOOST_TEST(len_namelist((const char **)names) == 3);
+    BOOST_TEST(std::string(names[0]) == "Heimdall");
+    BOOST_TEST(std::string(names[2]) == "Loki");
+    BOOST_TEST(buf.GetReadPosition() == buf.GetLength());
+    free_namelist(names);
+
+    buf.Clear();
+    buf.Append32(5);
+    buf.AppendString("Tyr");
+    ret = buf.ReadNames(&names, 0);
+    BOOST_TEST(ret == 1);
+    BOOST_TEST(len_namelist((const char **)names) == 0);
+    free_namelist(names);
+}
+
 BOOST_AUTO_TEST_CASE(bread1_test)
 {
     cNamelist list;
@@ -757,5 +757,54 @@ BOOST_AUTO_TEST_CASE(create_test)
     BOOST_TEST(std::string(color.get("ca")) == "ca bn");
 }
 
+BOOST_AUTO_TEST_CASE(partial_key_match_test)
+{
+    color_type color;
+    color.insert(std::string{"whisper:cg bn"});
+    color.insert(std::string{"who:cw bn"});
+    color.insert(std::string{"say:cy bn"});
+
+    std::string full_key;
+    BOOST_TEST(color.get("wh", full_key) == "cg bn");
+    BOOST_TEST(full_key == "whisper");
+    BOOST_TEST(color.get("who", full_key) == "cw bn");
+    BOOST_TEST(full_key == "who");
+
+    // Only keys that are a prefix of a keyword match, like the old lower_bound() lookup
+    BOOST_TEST(color.get("s") == "cy bn");
+    BOOST_TEST(color.get("sayings").empty());
+    BOOST_TEST(color.get("x").empty());
+    BOOST_TEST(color.get("").empty());
+
+    char full_name[64] = "";
+    BOOST_TEST(color.get("whi", full_name) == "cg bn");
+    BOOST_TEST(std::string(full_name) == "whisper");
+}
+
+BOOST_AUTO_TEST_CASE(get_reference_test)
+{
+    color_type color;
+    color.insert(std::string{"say:cy bn"});
+
+    // Lookups return the stored color, not a copy
+    const std::string &first = color.get("say");
+    BOOST_TEST(&first == &color.get(std::string{"say"}));
+    BOOST_TEST(&color.get("nothing") == &color.get("nothing either"));
+}
+
+BOOST_AUTO_TEST_CASE(key_string_overrides_test)
+{
+    color_type dft;
+    color_type player;
+    dft.create(std::string{"apples:oranges:pears:grapes:"});
+    (void)player.insert(std::string{"pears"}, std::string{"limes"});
+
+    std::string expected{"<div class='oranges'>apples                   = oranges</div><br/>"
+                         "<div class='limes'>pears                    = limes</div><br/><br/>"};
+    BOOST_TEST(player.key_string(dft) == expected);
+    BOOST_TEST(player.save_string() == "pears:limes:");
+    BOOST_TEST(dft.get("pears") == "grapes");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 #pragma GCC diagnostic pop
@@ -0,0 +1,207 @@
+#define BOOST_TEST_MODULE "db Unit Tests"
+#include "db.h"
+
+#include "FixtureBase.h"
+#include "config.h"
+#include "file_index_type.h"
+#include "files.h"
+#include "zone_reset_cmd.h"
+#include "zone_type.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+/**
+ * A zone compiled to a scratch directory, which is entered so the configured
+ * zone directory (relative to the bin directory) is inside it as well.
+ */
+struct ReloadFixture : public unit_tests::FixtureBase
+{
+    ReloadFixture()
+        : FixtureBase()
+    {
+        char tmpl[] = "/tmp/vme_reload_XXXXXX";
+        BOOST_REQUIRE(mkdtemp(tmpl) != nullptr);
+        scratch = tmpl;
+        std::filesystem::create_directories(scratch / "bin");
+        cwd = std::filesystem::current_path();
+        std::filesystem::current_path(scratch / "bin");
+        if (!g_cServerConfig.getZoneDir().empty())
+        {
+            std::filesystem::create_directories(g_cServerConfig.getZoneDir());
+        }
+
+        zone = new zone_type{"reloadtest"};
+        g_zone_info.mmp[zone->getName()] = zone;
+    }
+
+    ~ReloadFixture() override
+    {
+        fclose_cache(path(".data").c_str());
+        g_zone_info.mmp.erase(zone->getName());
+        delete zone;
+        std::filesystem::current_path(cwd);
+        std::filesystem::remove_all(scratch);
+    }
+
+    std::string path(const char *ext) const { return g_cServerConfig.getZoneDir() + zone->getName() + ext; }
+
+    static void put(FILE *f, const char *str) { fwrite(str, strlen(str) + 1, 1, f); }
+
+    template<typename T>
+    static void put(FILE *f, T value)
+    {
+        fwrite(&value, sizeof(value), 1, f);
+    }
+
+    /// A data file without templates and with one unit, 'thing', of 'type'
+    void write_data(ubit8 type, const char *title = "Reload test", ubit32 crc = 4242)
+    {
+        FILE *f = fopen(path(".data").c_str(), "wb");
+        BOOST_REQUIRE(f);
+        put(f, "reloadtest");
+        put(f, (int)0);       // weather
+        put(f, "notes");
+        put(f, "help");
+        put(f, "papi");
+        put(f, "");           // end of creators
+        put(f, title);
+        put(f, (ubit32)0);    // end of templates
+        put(f, "thing");
+        put(f, type);
+        put(f, (ubit32)4);    // length
+        put(f, (ubit32)42);   // data crc
+        put(f, crc);          // file crc
+        put(f, (ubit32)0);    // the unit data
+        fclose(f);
+    }
+
+    static void put_cmd(FILE *f, ubit8 cmd, const char *name, ubit8 direction)
+    {
+        put(f, cmd);
+        put(f, *name ? "reloadtest" : "");
+        put(f, name);
+        put(f, "");
+        put(f, "");
+        put(f, (sbit16)1);
+        put(f, (sbit16)2);
+        put(f, (sbit16)3);
+        put(f, (ubit8)0);
+        put(f, direction);
+    }
+
+    /// A load of 'thing' with a nested command, cut short after 'cut' bytes if not 0
+    void write_reset(long cut = 0)
+    {
+        FILE *f = fopen(path(".reset").c_str(), "wb");
+        BOOST_REQUIRE(f);
+        put(f, (ubit16)30);
+        put(f, (ubit8)1);
+        put_cmd(f, 1, "thing", 1);
+        put_cmd(f, 0, "", 2);
+        put(f, (ubit8)255);
+        fclose(f);
+
+        if (cut)
+        {
+            std::filesystem::resize_file(path(".reset"), cut);
+        }
+    }
+
+    std::filesystem::path scratch;
+    std::filesystem::path cwd;
+    zone_type *zone;
+};
+
+BOOST_FIXTURE_TEST_SUITE(db_cpp_tests, ReloadFixture)
+
+BOOST_AUTO_TEST_CASE(reload_twice_test)
+{
+    write_data(UNIT_ST_OBJ);
+    write_reset();
+
+    for (int i = 0; i < 2; i++)
+    {
+        BOOST_TEST(reload_zone(zone) == "");
+
+        file_index_type *fi = zone->findFileIndex("thing");
+        BOOST_REQUIRE(fi);
+        BOOST_TEST(fi->getLength() == 4);
+
+        zone_reset_cmd *cmd = zone->getZoneResetCommands();
+        BOOST_REQUIRE(cmd);
+        BOOST_TEST(cmd->getFileIndexType(0) == fi);
+        BOOST_TEST(cmd->getNum(2) == 3);
+        BOOST_TEST(cmd->getNext() == nullptr);
+        BOOST_REQUIRE(cmd->getNested());
+        BOOST_TEST(cmd->getNested()->getFileIndexType(0) == nullptr);
+        BOOST_TEST(zone->getZoneResetTime() == 30);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reload_bad_reset_test)
+{
+    write_data(UNIT_ST_OBJ);
+    write_reset();
+    BOOST_REQUIRE(reload_zone(zone) == "");
+    zone_reset_cmd *cmd = zone->getZoneResetCommands();
+
+    // Cut inside the nested command, the old resets stay
+    write_reset(40);
+    BOOST_TEST(reload_zone(zone) != "");
+    BOOST_TEST(zone->getZoneResetCommands() == cmd);
+
+    std::filesystem::remove(path(".reset"));
+    BOOST_TEST(reload_zone(zone) != "");
+    BOOST_TEST(zone->getZoneResetCommands() == cmd);
+}
+
+BOOST_AUTO_TEST_CASE(reload_type_change_test)
+{
+    write_data(UNIT_ST_OBJ);
+    write_reset();
+    BOOST_REQUIRE(reload_zone(zone) == "");
+
+    // Refused before the zone is touched, so units of it are not slimed
+    write_data(UNIT_ST_NPC, "Changed", 4343);
+    std::string err = reload_zone(zone);
+    BOOST_TEST(err.find("changed unit type") != std::string::npos);
+    BOOST_TEST(zone->findFileIndex("thing")->getType() == UNIT_ST_OBJ);
+    BOOST_TEST(zone->findFileIndex("thing")->getLength() == 4);
+    BOOST_TEST(zone->getTitle() == "Reload test");
+    BOOST_TEST(zone->getCrc() == 4242U);
+}
+
+BOOST_AUTO_TEST_CASE(reload_bad_data_test)
+{
+    write_data(UNIT_ST_OBJ);
+    write_reset();
+    BOOST_REQUIRE(reload_zone(zone) == "");
+
+    // Cut in the header, the unit name, the unit record and the unit data
+    write_data(UNIT_ST_OBJ, "Changed", 4343);
+    auto size = std::filesystem::file_size(path(".data"));
+    for (auto cut : {(decltype(size))20, size - 20, size - 10, size - 2})
+    {
+        write_data(UNIT_ST_OBJ, "Changed", 4343);
+        std::filesystem::resize_file(path(".data"), cut);
+
+        BOOST_TEST(reload_zone(zone) != "");
+        BOOST_TEST(zone->getTitle() == "Reload test");
+        BOOST_TEST(zone->getCrc() == 4242U);
+        BOOST_TEST(zone->findFileIndex("thing")->getLength() == 4);
+    }
+
+    // The whole file is taken
+    write_data(UNIT_ST_OBJ, "Changed", 4343);
+    BOOST_TEST(reload_zone(zone) == "");
+    BOOST_TEST(zone->getTitle() == "Changed");
+    BOOST_TEST(zone->getCrc() == 4343U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,99 @@
+#define BOOST_TEST_MODULE "dilinst Unit Tests"
+#include "dilinst.h"
+
+#include "FixtureBase.h"
+#include "bytestring.h"
+#include "dil.h"
+#include "textutil.h"
+
+#include <boost/test/unit_test.hpp>
+
+/**
+ * A program on a template of 32 bytes of core, with its pc on the address
+ * operand of a jump at 0. Deleting the program frees the template.
+ */
+struct JumpFixture : public unit_tests::FixtureBase
+{
+    JumpFixture()
+        : FixtureBase()
+    {
+        CREATE(tmpl, diltemplate, 1);
+        tmpl->prgname = str_dup("jumps");
+        tmpl->coresz = 32;
+        CREATE(tmpl->core, ubit8, tmpl->coresz);
+
+        prg = new dilprg(nullptr, tmpl);
+        prg->fp->tmpl = tmpl;
+    }
+
+    ~JumpFixture() override { delete prg; }
+
+    /// A jump at 0 to 'operand', with the pc past the opcode as the interpreter leaves it
+    void jump(ubit8 opcode, ubit32 operand)
+    {
+        ubit8 *wtmp = tmpl->core;
+        bwrite_ubit8(&wtmp, opcode);
+        bwrite_ubit32(&wtmp, operand);
+        prg->fp->pc = tmpl->core + 1;
+    }
+
+    void push(sbit32 num)
+    {
+        auto *v = new dilval;
+        v->type = DilVarType_e::DILV_INT;
+        v->val.num = num;
+        prg->stack.push(v);
+    }
+
+    diltemplate *tmpl;
+    dilprg *prg;
+};
+
+BOOST_FIXTURE_TEST_SUITE(dilinst_cpp_tests, JumpFixture)
+
+BOOST_AUTO_TEST_CASE(goto_test)
+{
+    jump(DILI_GOTO, 20);
+    prg->waitcmd = 100;
+    dilfi_goto(prg);
+    BOOST_TEST(prg->fp->pc == tmpl->core + 20);
+    BOOST_TEST(prg->waitcmd == 99);
+}
+
+BOOST_AUTO_TEST_CASE(threaded_goto_test)
+{
+    // Lands where two more GOTOs would have taken it, and pays for them
+    jump(DILI_GOTO, (2 << 24) | 20);
+    prg->waitcmd = 100;
+    dilfi_goto(prg);
+    BOOST_TEST(prg->fp->pc == tmpl->core + 20);
+    BOOST_TEST(prg->waitcmd == 97);
+
+    // Never charged below nothing
+    jump(DILI_GOTO, (DIL_JUMP_MAXSKIP << 24) | 20);
+    prg->waitcmd = 10;
+    dilfi_goto(prg);
+    BOOST_TEST(prg->fp->pc == tmpl->core + 20);
+    BOOST_TEST(prg->waitcmd == 0);
+}
+
+BOOST_AUTO_TEST_CASE(threaded_if_test)
+{
+    // Taken to the else branch, the skipped GOTOs are charged
+    jump(DILI_IF, (3 << 24) | 24);
+    push(0);
+    prg->waitcmd = 100;
+    dilfi_if(prg);
+    BOOST_TEST(prg->fp->pc == tmpl->core + 24);
+    BOOST_TEST(prg->waitcmd == 96);
+
+    // Falling through does not jump, so it costs the IF alone
+    jump(DILI_IF, (3 << 24) | 24);
+    push(1);
+    prg->waitcmd = 100;
+    dilfi_if(prg);
+    BOOST_TEST(prg->fp->pc == tmpl->core + 5);
+    BOOST_TEST(prg->waitcmd == 99);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
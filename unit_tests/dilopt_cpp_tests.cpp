@@ -0,0 +1,95 @@
+#include "dilopt.h"
+
+#include "bytestring.h"
+#include "dil.h"
+
+#include <cstring>
+
+#include <boost/test/unit_test.hpp>
+
+/**
+ * Code with an IF at 0 to 10 and GOTOs at 5 to 20, at 10 to 15 and at 15
+ * to 20, where a QUIT ends it.
+ */
+struct ThreadFixture
+{
+    ThreadFixture()
+    {
+        memset(core, 0, sizeof(core));
+        put(0, DILI_IF, 10);
+        put(5, DILI_GOTO, 20);
+        put(10, DILI_GOTO, 15);
+        put(15, DILI_GOTO, 20);
+        core[20] = DILI_QUIT;
+    }
+
+    void put(ubit32 at, ubit8 opcode, ubit32 operand)
+    {
+        ubit8 *wtmp = &core[at];
+        bwrite_ubit8(&wtmp, opcode);
+        bwrite_ubit32(&wtmp, operand);
+    }
+
+    ubit32 operand(ubit32 at)
+    {
+        ubit8 *rtmp = &core[at + 1];
+        return bread_ubit32(&rtmp);
+    }
+
+    ubit8 core[21];
+};
+
+BOOST_FIXTURE_TEST_SUITE(dilopt_cpp_tests, ThreadFixture)
+
+BOOST_AUTO_TEST_CASE(thread_jumps_test)
+{
+    ubit32 jumps[] = {1, 6, 11, 16};
+
+    BOOST_TEST(dil_thread_jumps(core, sizeof(core), jumps, 4) == 2);
+
+    // The IF skips the GOTOs at 10 and 15, the GOTO at 10 the one at 15
+    BOOST_TEST(operand(0) == ((2U << 24) | 20));
+    BOOST_TEST(operand(10) == ((1U << 24) | 20));
+    BOOST_TEST(operand(5) == 20U);
+    BOOST_TEST(operand(15) == 20U);
+    BOOST_TEST(DIL_JUMP_ADR(operand(0)) == 20U);
+    BOOST_TEST(DIL_JUMP_SKIPPED(operand(0)) == 2U);
+}
+
+BOOST_AUTO_TEST_CASE(thread_threaded_test)
+{
+    // The IF through a GOTO that is threaded already takes over its skips
+    ubit32 jumps[] = {11, 1};
+
+    BOOST_TEST(dil_thread_jumps(core, sizeof(core), jumps, 2) == 2);
+    BOOST_TEST(operand(10) == ((1U << 24) | 20));
+    BOOST_TEST(operand(0) == ((2U << 24) | 20));
+}
+
+BOOST_AUTO_TEST_CASE(thread_loop_test)
+{
+    // A GOTO to itself stops when it can not count any more skips
+    ubit32 jumps[] = {6};
+
+    put(5, DILI_GOTO, 5);
+    BOOST_TEST(dil_thread_jumps(core, sizeof(core), jumps, 1) == 1);
+    BOOST_TEST(operand(5) == (((ubit32)DIL_JUMP_MAXSKIP << 24) | 5));
+}
+
+BOOST_AUTO_TEST_CASE(fold_compare_test)
+{
+    sbit32 result = -1;
+
+    BOOST_TEST((dil_fold_compare(DILE_EQ, 3, 3, &result) && result == 1));
+    BOOST_TEST((dil_fold_compare(DILE_NE, 3, 3, &result) && result == 0));
+    BOOST_TEST((dil_fold_compare(DILE_GT, 4, 3, &result) && result == 1));
+    BOOST_TEST((dil_fold_compare(DILE_LT, 4, 3, &result) && result == 0));
+    BOOST_TEST((dil_fold_compare(DILE_GE, -2, -2, &result) && result == 1));
+    BOOST_TEST((dil_fold_compare(DILE_LE, 5, -2, &result) && result == 0));
+
+    result = 7;
+    BOOST_TEST(!dil_fold_compare(DILE_INT, 1, 2, &result));
+    BOOST_TEST(result == 7);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
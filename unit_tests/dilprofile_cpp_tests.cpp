@@ -0,0 +1,146 @@
+#define BOOST_TEST_MODULE "dilprofile Unit Tests"
+#include "dilprofile.h"
+
+#include "FixtureBase.h"
+#include "bytestring.h"
+#include "db_file.h"
+#include "textutil.h"
+#include "zone_type.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+/**
+ * A zone with two templates of 32 bytes of core. Statements of 'prog'
+ * start at core offsets 0, 10 and 20 on source lines 5, 7 and 12, those
+ * of 'func' at 0 and 16 on lines 30 and 31. The zone frees them.
+ */
+struct ProfileFixture : public unit_tests::FixtureBase
+{
+    ProfileFixture()
+        : FixtureBase()
+        , zone("profzone")
+    {
+        tmpl = make_template("prog", 5, 10, 7, 20, 12);
+        func = make_template("func", 30, 16, 31, 0, 0);
+        zone.insertDILTemplate(std::unique_ptr<diltemplate>(tmpl));
+        zone.insertDILTemplate(std::unique_ptr<diltemplate>(func));
+    }
+
+    diltemplate *make_template(const char *name, ubit32 line0, ubit32 pc1, ubit32 line1, ubit32 pc2, ubit32 line2)
+    {
+        diltemplate *t = nullptr;
+        CREATE(t, diltemplate, 1);
+        t->prgname = str_dup(name);
+        t->zone = &zone;
+        t->coresz = 32;
+        CREATE(t->core, ubit8, t->coresz);
+        t->nLines = pc2 ? 3 : 2;
+        CREATE(t->lines, ubit32, 2 * t->nLines);
+        ubit32 table[] = {0, line0, pc1, line1, pc2, line2};
+        memcpy(t->lines, table, 2 * t->nLines * sizeof(ubit32));
+        CREATE(t->lineSamples, ubit32, t->nLines);
+        return t;
+    }
+
+    zone_type zone;
+    diltemplate *tmpl;
+    diltemplate *func;
+};
+
+BOOST_FIXTURE_TEST_SUITE(dilprofile_cpp_tests, ProfileFixture)
+
+BOOST_AUTO_TEST_CASE(source_line_test)
+{
+    BOOST_TEST(dil_source_line(tmpl, tmpl->core) == 5U);
+    BOOST_TEST(dil_source_line(tmpl, tmpl->core + 9) == 5U);
+    BOOST_TEST(dil_source_line(tmpl, tmpl->core + 10) == 7U);
+    BOOST_TEST(dil_source_line(tmpl, tmpl->core + 19) == 7U);
+    BOOST_TEST(dil_source_line(tmpl, tmpl->core + 20) == 12U);
+    BOOST_TEST(dil_source_line(tmpl, tmpl->core + 31) == 12U);
+    BOOST_TEST(dil_line_index(tmpl, tmpl->core + 15) == 1);
+
+    // No table, no line
+    ubit32 n = tmpl->nLines;
+    tmpl->nLines = 0;
+    BOOST_TEST(dil_source_line(tmpl, tmpl->core + 15) == 0U);
+    BOOST_TEST(dil_line_index(tmpl, tmpl->core + 15) == -1);
+    tmpl->nLines = n;
+}
+
+BOOST_AUTO_TEST_CASE(line_table_io_test)
+{
+    CByteBuffer buf;
+    diltemplate copy;
+
+    bwrite_dillines(&buf, tmpl);
+    BOOST_TEST(buf.GetLength() == (1 + 2 * 3) * sizeof(ubit32));
+
+    memset(&copy, 0, sizeof(copy));
+    bread_dillines(&buf, &copy);
+    BOOST_TEST(buf.GetReadPosition() == buf.GetLength());
+    BOOST_REQUIRE(copy.nLines == 3U);
+    BOOST_TEST(memcmp(copy.lines, tmpl->lines, 2 * 3 * sizeof(ubit32)) == 0);
+    BOOST_TEST(copy.lineSamples != nullptr);
+    FREE(copy.lines);
+    FREE(copy.lineSamples);
+
+    // Nothing after the template, the template has no table
+    bread_dillines(&buf, &copy);
+    BOOST_TEST(copy.nLines == 0U);
+    BOOST_TEST(copy.lines == nullptr);
+
+    // A count that does not fit the rest of the buffer is ignored
+    buf.Clear();
+    buf.Append32(1000);
+    buf.Append32(0);
+    copy.prgname = tmpl->prgname;
+    bread_dillines(&buf, &copy);
+    BOOST_TEST(copy.nLines == 0U);
+    BOOST_TEST(buf.GetReadPosition() == buf.GetLength());
+}
+
+BOOST_AUTO_TEST_CASE(sample_test)
+{
+    // Never freed, see dilstring_cpp_tests
+    static dilprg *prg = new dilprg(nullptr, nullptr);
+
+    RECREATE(prg->frame, dilframe, 2);
+    prg->frame[0].tmpl = tmpl;
+    prg->frame[0].pc = tmpl->core + 12; // Called func from line 7
+    prg->frame[1].tmpl = func;
+    prg->frame[1].pc = func->core + 17; // About to run offset 16, line 31
+    prg->fp = &prg->frame[1];
+
+    g_dil_profile_countdown = 2;
+    dil_profile_tick(prg);
+    BOOST_TEST(func->nSamples == 0U);
+    dil_profile_tick(prg);
+    BOOST_TEST(func->nSamples == 1U);
+    BOOST_TEST(func->lineSamples[1] == 1U);
+    BOOST_TEST(g_dil_profile_countdown == (ubit32)DIL_PROFILE_INTERVAL);
+
+    prg->fp = prg->frame;
+    dil_profile_sample(prg);
+    dil_profile_sample(prg);
+    BOOST_TEST(tmpl->lineSamples[1] == 2U);
+
+    BOOST_TEST(zone.getStatDILProfile(true) == "prog@profzone:7 2<br/>"
+                                                "prog@profzone:7;func@profzone:31 1<br/>");
+    BOOST_TEST(zone.getStatDILProfile(false) == "       2  prog:7<br/>"
+                                                 "       1  func:31<br/>");
+
+    prg->frame[0].tmpl = nullptr;
+    prg->frame[1].tmpl = nullptr;
+    prg->fp = prg->frame;
+
+    zone.resetDILProfile();
+    BOOST_TEST(zone.getStatDILProfile(true).empty());
+    BOOST_TEST(zone.getStatDILProfile(false).empty());
+    BOOST_TEST(tmpl->lineSamples[1] == 0U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,186 @@
+#define BOOST_TEST_MODULE "dilstring Unit Tests"
+#include "dilstring.h"
+
+#include "dil.h"
+#include "dilexp.h"
+#include "dilshare.h"
+
+#include <cstring>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+/**
+ * The dilprg destructor expects a linked template, so the program used
+ * for evaluating expressions is created once and never freed.
+ */
+static dilprg *test_prg()
+{
+    static dilprg *prg = new dilprg(nullptr, nullptr);
+    return prg;
+}
+
+static dilval *str_val(const char *str, ubit8 atyp = DILA_STR)
+{
+    auto *v = new dilval;
+    v->type = DILV_SP;
+    v->atyp = atyp;
+    v->val.ptr = (atyp == DILA_STR) ? dilstr_new(str) : (char *)str;
+    return v;
+}
+
+/**
+ * Push the arguments, evaluate the expression and return the result,
+ * which the caller deletes.
+ */
+static dilval *eval(void (*fn)(dilprg *), std::initializer_list<dilval *> args)
+{
+    dilprg *p = test_prg();
+    for (auto *v : args)
+    {
+        p->stack.push(v);
+    }
+    fn(p);
+    return p->stack.pop();
+}
+
+BOOST_AUTO_TEST_SUITE(dilstring_cpp_tests)
+
+BOOST_AUTO_TEST_CASE(dilstr_basic_test)
+{
+    char *s = dilstr_new("Hello World");
+    BOOST_TEST(std::string(s) == "Hello World");
+    BOOST_TEST(dilstr_len(s) == 11U);
+    BOOST_TEST(dilstr_refs(s) == 1U);
+
+    char *t = dilstr_ref(s);
+    BOOST_TEST((void *)t == (void *)s);
+    BOOST_TEST(dilstr_refs(s) == 2U);
+
+    dilstr_free(t);
+    BOOST_TEST(dilstr_refs(s) == 1U);
+    dilstr_free(s);
+
+    BOOST_TEST(dilstr_new(nullptr) == nullptr);
+    BOOST_TEST(dilstr_len(nullptr) == 0U);
+    dilstr_free(nullptr);
+
+    char *e = dilstr_new("");
+    BOOST_TEST(e != nullptr);
+    BOOST_TEST(*e == '\0');
+    BOOST_TEST(dilstr_len(e) == 0U);
+    dilstr_free(e);
+}
+
+BOOST_AUTO_TEST_CASE(dil_str_copy_test)
+{
+    dilval *v = str_val("shared");
+    char *c = dil_str_copy(v);
+    BOOST_TEST((void *)c == v->val.ptr);
+    BOOST_TEST(dilstr_refs(c) == 2U);
+    delete v;
+    BOOST_TEST(dilstr_refs(c) == 1U);
+    BOOST_TEST(std::string(c) == "shared");
+    dilstr_free(c);
+
+    dilval *n = str_val("core constant", DILA_NORM);
+    c = dil_str_copy(n);
+    BOOST_TEST((void *)c != n->val.ptr);
+    BOOST_TEST(dil_str_len(n) == strlen("core constant"));
+    BOOST_TEST(dilstr_len(c) == strlen("core constant"));
+    dilstr_free(c);
+    delete n;
+}
+
+BOOST_AUTO_TEST_CASE(dilfe_plus_test)
+{
+    dilval *r = eval(dilfe_plus, {str_val("foo", DILA_NORM), str_val("bar")});
+    BOOST_TEST(r->atyp == DILA_STR);
+    BOOST_TEST(std::string((char *)r->val.ptr) == "foobar");
+    BOOST_TEST(dilstr_len((char *)r->val.ptr) == 6U);
+    delete r;
+
+    // Adding an empty string shares the other operand
+    dilval *a = str_val("unchanged");
+    char *s = dilstr_ref((char *)a->val.ptr);
+    r = eval(dilfe_plus, {a, str_val("")});
+    BOOST_TEST(r->val.ptr == (void *)s);
+    delete r;
+    dilstr_free(s);
+
+    r = eval(dilfe_plus, {str_val(nullptr, DILA_NORM), str_val(nullptr, DILA_NORM)});
+    BOOST_TEST(std::string((char *)r->val.ptr).empty());
+    delete r;
+}
+
+BOOST_AUTO_TEST_CASE(dilfe_replace_test)
+{
+    // replace(search, replacement, subject)
+    dilval *r = eval(dilfe_replace, {str_val("o"), str_val("00"), str_val("foo boo")});
+    BOOST_TEST(std::string((char *)r->val.ptr) == "f0000 b0000");
+    BOOST_TEST(dilstr_len((char *)r->val.ptr) == 11U);
+    delete r;
+
+    r = eval(dilfe_replace, {str_val("aa"), str_val("a", DILA_NORM), str_val("aaaaa")});
+    BOOST_TEST(std::string((char *)r->val.ptr) == "aaa");
+    delete r;
+
+    r = eval(dilfe_replace, {str_val("lo w"), str_val(""), str_val("hello world")});
+    BOOST_TEST(std::string((char *)r->val.ptr) == "helorld");
+    delete r;
+
+    // Nothing to replace shares the subject
+    dilval *subj = str_val("nothing here");
+    char *s = dilstr_ref((char *)subj->val.ptr);
+    r = eval(dilfe_replace, {str_val("xyz"), str_val("abc"), subj});
+    BOOST_TEST(r->val.ptr == (void *)s);
+    delete r;
+    dilstr_free(s);
+
+    r = eval(dilfe_replace, {str_val(""), str_val("abc"), str_val("empty search")});
+    BOOST_TEST(std::string((char *)r->val.ptr) == "empty search");
+    delete r;
+}
+
+BOOST_AUTO_TEST_CASE(dilfe_tolower_test)
+{
+    dilval *r = eval(dilfe_tolower, {str_val("MiXeD Case")});
+    BOOST_TEST(std::string((char *)r->val.ptr) == "mixed case");
+    delete r;
+
+    dilval *a = str_val("already lower");
+    char *s = dilstr_ref((char *)a->val.ptr);
+    r = eval(dilfe_tolower, {a});
+    BOOST_TEST(r->val.ptr == (void *)s);
+    delete r;
+    dilstr_free(s);
+}
+
+BOOST_AUTO_TEST_CASE(dilfe_compare_test)
+{
+    dilval *r = eval(dilfe_se, {str_val("Hello"), str_val("hELLO")});
+    BOOST_TEST(r->val.num == TRUE);
+    delete r;
+
+    r = eval(dilfe_se, {str_val("Hello"), str_val("Hello!")});
+    BOOST_TEST(r->val.num == FALSE);
+    delete r;
+
+    r = eval(dilfe_se, {str_val("Hello", DILA_NORM), str_val("hello")});
+    BOOST_TEST(r->val.num == TRUE);
+    delete r;
+
+    r = eval(dilfe_slt, {str_val("Apple"), str_val("banana")});
+    BOOST_TEST(r->val.num == TRUE);
+    delete r;
+
+    r = eval(dilfe_slt, {str_val("apple"), str_val("APPLE")});
+    BOOST_TEST(r->val.num == FALSE);
+    delete r;
+
+    r = eval(dilfe_len, {str_val("twelve chars")});
+    BOOST_TEST(r->val.num == 12);
+    delete r;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
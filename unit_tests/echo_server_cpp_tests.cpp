@@ -0,0 +1,144 @@
+#define BOOST_TEST_MODULE "echo_server Unit Tests"
+#include "echo_server.h"
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <boost/asio/ip/address_v4.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace mplex;
+
+/**
+ * A websocket server on a loopback port that sends 'text' to each client
+ * as it connects, counting what it sent in 'stats'. The server runs on a
+ * thread of its own, the tests are the client.
+ */
+struct EchoServerFixture
+{
+    EchoServerFixture()
+        : text(2000, 'a')
+    {
+        server.clear_access_channels(websocketpp::log::alevel::all);
+        server.clear_error_channels(websocketpp::log::elevel::all);
+        server.init_asio();
+        server.set_open_handler([this](websocketpp::connection_hdl hdl) { sent = ws_send_message(&server, hdl, text.c_str(), &stats); });
+        server.listen(boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+        boost::system::error_code ec;
+        port = server.get_local_endpoint(ec).port();
+        BOOST_REQUIRE(!ec);
+        server.start_accept();
+        thread = std::thread([this]() { server.run(); });
+    }
+
+    ~EchoServerFixture() { stop(); }
+
+    /// Stop the server, after which what it counted can be read
+    void stop()
+    {
+        server.stop();
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+
+    /// Open a websocket, offering 'extensions' if not empty, and return the first two bytes of the first frame
+    std::string first_frame(const std::string &extensions)
+    {
+        sockaddr_in sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sin_family = AF_INET;
+        sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        sa.sin_port = htons(port);
+
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        BOOST_REQUIRE(fd >= 0);
+        timeval tv{5, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        BOOST_REQUIRE(connect(fd, (sockaddr *)&sa, sizeof(sa)) == 0);
+
+        std::string req = "GET / HTTP/1.1\r\n"
+                          "Host: 127.0.0.1\r\n"
+                          "Upgrade: websocket\r\n"
+                          "Connection: Upgrade\r\n"
+                          "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+                          "Sec-WebSocket-Version: 13\r\n";
+        if (!extensions.empty())
+        {
+            req += "Sec-WebSocket-Extensions: " + extensions + "\r\n";
+        }
+        req += "\r\n";
+        BOOST_REQUIRE(write(fd, req.c_str(), req.length()) == (ssize_t)req.length());
+
+        // The handshake response, then the frame header
+        std::string in;
+        char c = 0;
+        while (in.find("\r\n\r\n") == std::string::npos && read(fd, &c, 1) == 1)
+        {
+            in += c;
+        }
+        response = in;
+
+        std::string frame;
+        while (frame.length() < 2 && read(fd, &c, 1) == 1)
+        {
+            frame += c;
+        }
+        close(fd);
+
+        return frame;
+    }
+
+    std::string text;
+    std::string response;
+    ws_stats stats;
+    int sent{0};
+    wsserver server;
+    unsigned short port{0};
+    std::thread thread;
+};
+
+BOOST_FIXTURE_TEST_SUITE(echo_server_cpp_tests, EchoServerFixture)
+
+BOOST_AUTO_TEST_CASE(deflate_test)
+{
+    std::string frame = first_frame("permessage-deflate; client_max_window_bits");
+
+    BOOST_TEST(response.find("permessage-deflate") != std::string::npos);
+    BOOST_REQUIRE(frame.length() == 2);
+
+    // FIN, RSV1 (compressed) and text, far shorter than the text
+    BOOST_TEST((ubit8)frame[0] == 0xC1);
+    BOOST_TEST(((ubit8)frame[1] & 0x7F) < 126);
+
+    stop();
+    BOOST_TEST(sent == 1);
+    BOOST_TEST(stats.messages == 1U);
+    BOOST_TEST(stats.bytes == text.length());
+    BOOST_TEST(stats.deflated > 0U);
+    BOOST_TEST(stats.deflated < text.length());
+}
+
+BOOST_AUTO_TEST_CASE(plain_test)
+{
+    // A client not offering the extension is sent plain frames
+    std::string frame = first_frame("");
+
+    BOOST_TEST(response.find("permessage-deflate") == std::string::npos);
+    BOOST_REQUIRE(frame.length() == 2);
+    BOOST_TEST((ubit8)frame[0] == 0x81);
+    BOOST_TEST(((ubit8)frame[1] & 0x7F) == 126);
+
+    stop();
+    BOOST_TEST(sent == 1);
+    BOOST_TEST(stats.bytes == text.length());
+    BOOST_TEST(stats.deflated == 0U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,115 @@
+#define BOOST_TEST_MODULE "eliza Unit Tests"
+#include "FixtureBase.h"
+#include "eliza.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+// Imported prototypes for testing
+int trykeywd(char *line, int *score);
+
+/**
+ * Eliza reads its talk file relative to the etc directory, so boot it from there once.
+ * FixtureBase gives each test a fresh log file, other fixtures close theirs.
+ */
+struct ElizaFixture : public unit_tests::FixtureBase
+{
+    ElizaFixture()
+        : FixtureBase()
+    {
+        static bool booted = false;
+        if (!booted)
+        {
+            char cwd[1024];
+            BOOST_REQUIRE(getcwd(cwd, sizeof(cwd)) != nullptr);
+            BOOST_REQUIRE(chdir("../etc") == 0);
+            eliza_boot();
+            BOOST_REQUIRE(chdir(cwd) == 0);
+            booted = true;
+        }
+    }
+};
+
+/**
+ * A recorded conversation with an oracle, already run through preprocess_string(),
+ * together with the keyword index and priority trykeywd() picked for each line
+ * with the random number generator seeded to the line number.
+ */
+struct recorded_line
+{
+    const char *line;
+    int index;
+    int score;
+};
+
+static const recorded_line conversation[] = {
+    {" hello there ", 196, 52},
+    {" i am afraid of the dark ", 8, 53},
+    {" my brother is always angry with me ", 20, 54},
+    {" i need some advice about my boss ", 7, 54},
+    {" goodbye ", 62, 52},
+    {" i had an accident on my adventure ", 6, 54},
+    {" can you help me with my computer ", 78, 54},
+    {" i feel so alone and depressed ", 16, 53},
+    {" do you like beer or alcohol ", 39, 53},
+    {" my mother hates my boyfriend ", 193, 53},
+    {" why do you always blame me ", 45, 53},
+    {" i think my cat is dead ", 64, 53},
+    {" i dream about death every night ", 92, 53},
+    {" you are a stupid computer ", 327, 54},
+    {" my children never listen to me ", 266, 53},
+    {" i want to change my life ", 68, 53},
+    {" what is the chance of rain ", 67, 53},
+    {" can i trust you ", -1, -1},
+    {" i lost my money in a bet ", 252, 54},
+    {" where is the bar ", 36, 53},
+    {" my friends think i am crazy ", 87, 53},
+    {" i am anxious about the conflict with my father ", 22, 54},
+    {" bye bye adios ", 62, 52},
+    {" the corpse in the room smells ", 75, 56},
+    {" do you believe in christ or atheism ", 69, 53},
+    {" i hate my job and my boss ", 192, 53},
+    {" tell me about your brain ", 51, 53},
+    {" i can not decide what to do ", 93, 53},
+    {" is this a dream ", 113, 53},
+    {" xyzzy plugh ", -1, -1},
+};
+
+BOOST_FIXTURE_TEST_SUITE(eliza_cpp_tests, ElizaFixture)
+
+BOOST_AUTO_TEST_CASE(trykeywd_recorded_conversation_test)
+{
+    int seed = 0;
+
+    for (const auto &rec : conversation)
+    {
+        char buf[400];
+        int score = 0;
+
+        strcpy(buf, rec.line);
+        srand(++seed);
+        int index = trykeywd(buf, &score);
+
+        BOOST_TEST_CONTEXT("line [" << rec.line << "]")
+        {
+            BOOST_TEST(index == rec.index);
+            BOOST_TEST(score == rec.score);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(trykeywd_no_keyword_test)
+{
+    char buf[] = " zzz qqq xyzzy ";
+    int score = 0;
+
+    BOOST_TEST(trykeywd(buf, &score) == -1);
+    BOOST_TEST(score == -1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
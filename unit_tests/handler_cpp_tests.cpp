@@ -0,0 +1,340 @@
+#define BOOST_TEST_MODULE "handler Unit Tests"
+#include "handler.h"
+
+#include "FixtureBase.h"
+#include "db.h"
+#include "descriptor_data.h"
+#include "destruct.h"
+#include "file_index_type.h"
+#include "main_functions.h"
+#include "unit_data.h"
+#include "unitfind.h"
+#include "utils.h"
+#include "zon_basis.h"
+#include "zone_type.h"
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+/**
+ * A room in each of two zones and two objects of zone 'a', none of them
+ * in the global unit list.
+ */
+struct HandlerFixture : public unit_tests::FixtureBase
+{
+    HandlerFixture()
+        : FixtureBase()
+        , zone_a("a")
+        , zone_b("b")
+        , fi_room_a(&zone_a, "room_a", UNIT_ST_ROOM)
+        , fi_room_b(&zone_b, "room_b", UNIT_ST_ROOM)
+        , fi_obj(&zone_a, "obj", UNIT_ST_OBJ)
+    {
+        room_a = make(UNIT_ST_ROOM, &fi_room_a);
+        room_b = make(UNIT_ST_ROOM, &fi_room_b);
+        bag = make(UNIT_ST_OBJ, &fi_obj);
+        item = make(UNIT_ST_OBJ, &fi_obj);
+    }
+
+    ~HandlerFixture() override
+    {
+        for (auto *u : {item, bag, room_b, room_a})
+        {
+            unit_from_unit(u);
+            delete u;
+        }
+    }
+
+    static unit_data *make(ubit8 type, file_index_type *fi)
+    {
+        unit_data *u = new_unit_data(type, nullptr);
+        u->setFileIndex(fi);
+        return u;
+    }
+
+    zone_type zone_a;
+    zone_type zone_b;
+    file_index_type fi_room_a;
+    file_index_type fi_room_b;
+    file_index_type fi_obj;
+    unit_data *room_a;
+    unit_data *room_b;
+    unit_data *bag;
+    unit_data *item;
+};
+
+BOOST_FIXTURE_TEST_SUITE(handler_cpp_tests, HandlerFixture)
+
+BOOST_AUTO_TEST_CASE(num_in_zone_test)
+{
+    // Units outside the world are in no zone
+    unit_to_unit(item, bag);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_a) == 0);
+
+    // Contents follow their container
+    unit_to_unit(bag, room_a);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_a) == 2);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_b) == 0);
+
+    // Moving inside the zone changes nothing
+    unit_up(item);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_a) == 2);
+    unit_down(item, bag);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_a) == 2);
+
+    unit_from_unit(bag);
+    unit_to_unit(bag, room_b);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_a) == 0);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_b) == 2);
+
+    // Taken out it stays counted until it enters a unit again or leaves the game
+    unit_from_unit(item);
+    BOOST_TEST(item->getLiftedZone() == &zone_b);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_b) == 2);
+    unit_zone_settle(item);
+    BOOST_TEST(item->getLiftedZone() == nullptr);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_b) == 1);
+
+    // Rooms are not counted, but a room moved into another zone takes its contents along
+    unit_to_unit(item, room_a);
+    unit_to_unit(room_a, room_b);
+    BOOST_TEST(fi_room_a.getNumInZone(&zone_b) == 0);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_a) == 0);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_b) == 2);
+
+    unit_from_unit(room_a);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_a) == 1);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_b) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(num_of_players_test)
+{
+    auto *d = new descriptor_data(nullptr);
+    unit_data *pc = d->getCharacter();
+
+    // Characters in the menu are not counted
+    unit_to_unit(pc, room_a);
+    BOOST_TEST(zone_a.getNumOfPlayers() == 0);
+
+    insert_in_unit_list(pc);
+    BOOST_TEST(zone_a.getNumOfPlayers() == 1);
+
+    // Carried along in a container
+    unit_from_unit(pc);
+    BOOST_TEST(zone_a.getNumOfPlayers() == 1);
+    unit_to_unit(bag, room_a);
+    unit_to_unit(pc, bag);
+    BOOST_TEST(zone_a.getNumOfPlayers() == 1);
+    unit_from_unit(bag);
+    unit_to_unit(bag, room_b);
+    BOOST_TEST(zone_a.getNumOfPlayers() == 0);
+    BOOST_TEST(zone_b.getNumOfPlayers() == 1);
+
+    // Link death and reconnect
+    d->setCharacter(nullptr);
+    BOOST_TEST(zone_b.getNumOfPlayers() == 0);
+    d->setCharacter(pc);
+    BOOST_TEST(zone_b.getNumOfPlayers() == 1);
+
+    remove_from_unit_list(pc);
+    BOOST_TEST(zone_b.getNumOfPlayers() == 0);
+
+    unit_from_unit(pc);
+    UCHAR(pc)->setDescriptor(nullptr);
+    g_descriptor_list = d->getNext();
+    delete pc;
+    delete d;
+}
+
+BOOST_AUTO_TEST_CASE(move_in_zone_test)
+{
+    file_index_type fi_room_a2(&zone_a, "room_a2", UNIT_ST_ROOM);
+    unit_data *room_a2 = make(UNIT_ST_ROOM, &fi_room_a2);
+    auto *d = new descriptor_data(nullptr);
+    unit_data *pc = d->getCharacter();
+
+    unit_to_unit(pc, room_a);
+    insert_in_unit_list(pc);
+    unit_to_unit(item, bag);
+    unit_to_unit(bag, pc);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_a) == 2);
+    BOOST_TEST(zone_a.getNumOfPlayers() == 1);
+
+    // Neither taking the character out nor putting it in another room of the zone recounts anything
+    unit_from_unit(pc);
+    BOOST_TEST(pc->getLiftedZone() == &zone_a);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_a) == 2);
+    BOOST_TEST(zone_a.getNumOfPlayers() == 1);
+    unit_to_unit(pc, room_a2);
+    BOOST_TEST(pc->getLiftedZone() == nullptr);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_a) == 2);
+    BOOST_TEST(zone_a.getNumOfPlayers() == 1);
+
+    // Taken out of a lifted unit, counted in the zone that unit left
+    unit_from_unit(pc);
+    unit_from_unit(bag);
+    BOOST_TEST(bag->getLiftedZone() == &zone_a);
+    unit_to_unit(bag, pc);
+    BOOST_TEST(bag->getLiftedZone() == nullptr);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_a) == 2);
+
+    // Recounted once, on arrival in another zone
+    unit_to_unit(pc, room_b);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_a) == 0);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_b) == 2);
+    BOOST_TEST(zone_a.getNumOfPlayers() == 0);
+    BOOST_TEST(zone_b.getNumOfPlayers() == 1);
+
+    // Leaving the game from the top level
+    unit_from_unit(pc);
+    remove_from_unit_list(pc);
+    BOOST_TEST(pc->getLiftedZone() == nullptr);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_b) == 0);
+    BOOST_TEST(zone_b.getNumOfPlayers() == 0);
+
+    unit_from_unit(bag);
+    UCHAR(pc)->setDescriptor(nullptr);
+    g_descriptor_list = d->getNext();
+    delete pc;
+    delete d;
+    delete room_a2;
+}
+
+BOOST_AUTO_TEST_CASE(extract_container_test)
+{
+    unit_data *box = make(UNIT_ST_OBJ, &fi_obj);
+    unit_data *a = make(UNIT_ST_OBJ, &fi_obj);
+    unit_data *b = make(UNIT_ST_OBJ, &fi_obj);
+    int in_mem = fi_obj.getNumInMem();
+
+    unit_to_unit(a, box);
+    unit_to_unit(b, box);
+    unit_to_unit(box, room_a);
+    for (auto *u : {box, a, b})
+    {
+        insert_in_unit_list(u);
+    }
+
+    unit_data *destroy_room = g_destroy_room;
+    g_destroy_room = room_b;
+    extract_unit(box);
+    g_destroy_room = destroy_room;
+
+    // The contents stay in the box, which leaves the game as a whole
+    BOOST_TEST(box->getUnitIn() == room_b);
+    BOOST_TEST(a->getUnitIn() == box);
+    BOOST_TEST(b->getUnitIn() == box);
+    BOOST_TEST(b->is_destructed());
+    BOOST_TEST((a->getGlobalNext() == nullptr && a->getGlobalPrevious() == nullptr && g_unit_list != a));
+    BOOST_TEST(fi_obj.getNumInZone(&zone_a) == 0);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_b) == 3);
+
+    clear_destructed();
+    BOOST_TEST(room_b->getUnitContains() == nullptr);
+    BOOST_TEST(room_b->getWeight() == 0);
+    BOOST_TEST(fi_obj.getNumInZone(&zone_b) == 0);
+    BOOST_TEST(fi_obj.getNumInMem() == in_mem - 3);
+}
+
+/// The chars inside 'in', first as found in the char list and then as found in the contents
+static void chars_inside(unit_data *in, std::vector<unit_data *> &chars, std::vector<unit_data *> &contents)
+{
+    for (unit_data *u = in->getCharContains(); u; u = u->getNextChar())
+    {
+        chars.push_back(u);
+    }
+    for (unit_data *u = in->getUnitContains(); u; u = u->getNext())
+    {
+        if (u->isChar())
+        {
+            contents.push_back(u);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(char_list_test)
+{
+    std::vector<unit_data *> guards;
+    for (int i = 0; i < 3; i++)
+    {
+        guards.push_back(make(UNIT_ST_NPC, nullptr));
+        guards.back()->getNames().AppendName("guard");
+    }
+    unit_data *g1 = guards[0];
+    unit_data *g2 = guards[1];
+    unit_data *g3 = guards[2];
+    item->getNames().AppendName("guard");
+
+    unit_to_unit(g1, room_a);
+    unit_to_unit(item, room_a);
+    unit_to_unit(g2, room_a);
+    unit_to_unit(bag, room_a);
+    unit_to_unit(g3, room_a);
+
+    // Same order as the contents, without the objects
+    std::vector<unit_data *> chars;
+    std::vector<unit_data *> contents;
+    chars_inside(room_a, chars, contents);
+    BOOST_TEST((chars == std::vector<unit_data *>{g3, g2, g1}));
+    BOOST_TEST((chars == contents));
+    BOOST_TEST(room_a->charsInCharList());
+
+    scan4_unit_room(room_a, UNIT_ST_NPC | UNIT_ST_PC);
+    BOOST_TEST(UVITOP == 3);
+    BOOST_TEST((UVI(0) == g3 && UVI(1) == g2 && UVI(2) == g1));
+
+    // Numbering follows the contents, the object of the same name does not count
+    char buf[] = "2.guard";
+    char *arg = buf;
+    BOOST_TEST(find_unit_general(item, g1, &arg, nullptr, FIND_UNIT_SURRO, UNIT_ST_NPC) == g2);
+
+    // A bag with a guard inside holds chars, so looking through it needs the contents
+    unit_down(g2, bag);
+    BOOST_TEST(room_a->getNumberOfCharacterHoldersInsideUnit() == 1);
+    BOOST_TEST(!room_a->charsInCharList());
+    BOOST_TEST(room_a->charsInCharList(bag));
+    chars.clear();
+    contents.clear();
+    chars_inside(room_a, chars, contents);
+    BOOST_TEST((chars == std::vector<unit_data *>{g3, g1}));
+    BOOST_TEST((chars == contents));
+    BOOST_TEST(bag->getCharContains() == g2);
+
+    bag->setUnitFlag(UNIT_FL_TRANS);
+    scan4_unit_room(room_a, UNIT_ST_NPC | UNIT_ST_PC);
+    BOOST_TEST(UVITOP == 3);
+    BOOST_TEST((UVI(0) == g3 && UVI(1) == g2 && UVI(2) == g1));
+
+    // The guard inside is seen from the room through the bag, and sees out of it
+    scan4_unit(g2, UNIT_ST_NPC);
+    BOOST_TEST(UVITOP == 2);
+    BOOST_TEST((UVI(0) == g3 && UVI(1) == g1));
+
+    // Back out in front, the bag no longer holds chars
+    unit_up(g2);
+    BOOST_TEST(room_a->getNumberOfCharacterHoldersInsideUnit() == 0);
+    BOOST_TEST(bag->getCharContains() == nullptr);
+    chars.clear();
+    contents.clear();
+    chars_inside(room_a, chars, contents);
+    BOOST_TEST((chars == std::vector<unit_data *>{g2, g3, g1}));
+    BOOST_TEST((chars == contents));
+
+    // A bag holding chars moves its count along
+    unit_down(g1, bag);
+    unit_from_unit(bag);
+    BOOST_TEST(room_a->getNumberOfCharacterHoldersInsideUnit() == 0);
+    unit_to_unit(bag, room_b);
+    BOOST_TEST(room_b->getNumberOfCharacterHoldersInsideUnit() == 1);
+    unit_from_unit(g1);
+    BOOST_TEST(room_b->getNumberOfCharacterHoldersInsideUnit() == 0);
+
+    for (auto *u : guards)
+    {
+        unit_from_unit(u);
+        delete u;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,181 @@
+#define BOOST_TEST_MODULE "hook Unit Tests"
+#include "hook.h"
+
+#include "FixtureBase.h"
+#include "protocol.h"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+class cTestHook : public cHook
+{
+protected:
+    void Input(int nFlags) override {}
+};
+
+/**
+ * Two hooks connected by a socket pair, the receiving end non blocking
+ * like the ones handed out by accept() and connect() in the game.
+ */
+struct HookFixture : public unit_tests::FixtureBase
+{
+    HookFixture()
+        : FixtureBase()
+    {
+        int sv[2];
+        BOOST_REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+        BOOST_REQUIRE(fcntl(sv[1], F_SETFL, O_NONBLOCK) == 0);
+        tx.Hook(sv[0]);
+        rx.Hook(sv[1]);
+    }
+
+    /// Parse the next frame, returning its type and text (if any)
+    int parse(ubit16 *id, std::string *text)
+    {
+        ubit16 len = 0;
+        char *data = nullptr;
+        ubit8 text_type = 0;
+
+        int p = protocol_parse_incoming(&rx, id, &len, &data, &text_type);
+        text->assign(data ? data : "");
+        if (data)
+        {
+            FREE(data);
+        }
+        return p;
+    }
+
+    cTestHook tx;
+    cTestHook rx;
+};
+
+BOOST_AUTO_TEST_SUITE(hook_cpp_tests)
+
+BOOST_AUTO_TEST_CASE(rx_buffer_test)
+{
+    cRxBuffer b;
+    ubit8 out[8];
+
+    BOOST_TEST(b.Bytes() == 0U);
+
+    ubit8 *p = b.Reserve(8);
+    BOOST_TEST(b.Space() >= 8U);
+    memcpy(p, "abcdefgh", 8);
+    b.Commit(8);
+    BOOST_TEST(b.Bytes() == 8U);
+
+    b.CutCopy(out, 3);
+    BOOST_TEST(std::string((char *)out, 3) == "abc");
+    BOOST_TEST(std::string((const char *)b.Data(), b.Bytes()) == "defgh");
+
+    // Reserving more than is left at the tail moves the unconsumed bytes to the front
+    p = b.Reserve(6);
+    BOOST_TEST((void *)b.Data() == (void *)(p - 5));
+    memcpy(p, "ijklmn", 6);
+    b.Commit(6);
+    BOOST_TEST(std::string((const char *)b.Data(), b.Bytes()) == "defghijklmn");
+
+    // Consuming everything rewinds the buffer
+    b.Cut(b.Bytes());
+    BOOST_TEST(b.Bytes() == 0U);
+    BOOST_TEST(b.Reserve(1) == b.Data());
+}
+
+BOOST_FIXTURE_TEST_CASE(parse_batch_test, HookFixture)
+{
+    ubit16 id = 0;
+    std::string text;
+
+    protocol_send_text(&tx, 7, "first", MULTI_TEXT_CHAR);
+    protocol_send_text(&tx, 8, "second", MULTI_PROMPT_CHAR);
+    protocol_send_ping(&tx);
+
+    // All three frames arrive in one read and are parsed from the buffer
+    BOOST_TEST(parse(&id, &text) == MULTI_TEXT_CHAR);
+    BOOST_TEST(id == 7);
+    BOOST_TEST(text == "first");
+    BOOST_TEST(rx.bufRX.Bytes() > 0U);
+
+    BOOST_TEST(parse(&id, &text) == MULTI_PROMPT_CHAR);
+    BOOST_TEST(id == 8);
+    BOOST_TEST(text == "second");
+
+    BOOST_TEST(parse(&id, &text) == MULTI_PING_CHAR);
+    BOOST_TEST(id == 0);
+
+    BOOST_TEST(parse(&id, &text) == 0);
+    BOOST_TEST(rx.bufRX.Bytes() == 0U);
+    BOOST_TEST(rx.IsHooked());
+}
+
+BOOST_FIXTURE_TEST_CASE(parse_partial_frame_test, HookFixture)
+{
+    ubit16 id = 0;
+    std::string text;
+    const char frame[] = "\x01" "F" "\x05\x00" "\x06\x00" "split";
+
+    // Header and half of the text, then the rest
+    BOOST_REQUIRE(write(tx.get_fd(), frame, 9) == 9);
+    BOOST_TEST(parse(&id, &text) == 0);
+    BOOST_TEST(rx.bufRX.Bytes() == 9U);
+
+    BOOST_REQUIRE(write(tx.get_fd(), frame + 9, 3) == 3);
+    BOOST_TEST(parse(&id, &text) == MULTI_TEXT_CHAR);
+    BOOST_TEST(id == 5);
+    BOOST_TEST(text == "split");
+}
+
+BOOST_FIXTURE_TEST_CASE(parse_session_test, HookFixture)
+{
+    ubit16 id = 0;
+    std::string text;
+
+    protocol_send_session(&tx, 9, "papi abcdef");
+    protocol_send_resume(&tx, 0, "17 4242 255 10.0.0.1 papi abcdef");
+    protocol_send_resume(&tx, 12, "17");
+
+    BOOST_TEST(parse(&id, &text) == MULTI_SESSION_CHAR);
+    BOOST_TEST(id == 9);
+    BOOST_TEST(text == "papi abcdef");
+
+    // The request from the mplex'er has no id yet, the confirmation has the new one
+    BOOST_TEST(parse(&id, &text) == MULTI_RESUME_CHAR);
+    BOOST_TEST(id == 0);
+    BOOST_TEST(text == "17 4242 255 10.0.0.1 papi abcdef");
+
+    BOOST_TEST(parse(&id, &text) == MULTI_RESUME_CHAR);
+    BOOST_TEST(id == 12);
+    BOOST_TEST(text == "17");
+
+    // A session always belongs to a connection
+    const char frame[] = "\x01" "M" "\x00\x00" "\x02\x00" "x";
+    BOOST_REQUIRE(write(tx.get_fd(), frame, 8) == 8);
+    BOOST_TEST(parse(&id, &text) == -2);
+}
+
+BOOST_FIXTURE_TEST_CASE(parse_large_frame_test, HookFixture)
+{
+    ubit16 id = 0;
+    std::string text;
+    std::string big(20000, 'x');
+
+    // Bigger than a single read, so the buffer has to grow
+    protocol_send_text(&tx, 3, big.c_str(), MULTI_TEXT_CHAR);
+    protocol_send_text(&tx, 4, "after", MULTI_TEXT_CHAR);
+
+    BOOST_TEST(parse(&id, &text) == MULTI_TEXT_CHAR);
+    BOOST_TEST(id == 3);
+    BOOST_TEST(text == big);
+
+    BOOST_TEST(parse(&id, &text) == MULTI_TEXT_CHAR);
+    BOOST_TEST(id == 4);
+    BOOST_TEST(text == "after");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,59 @@
+#define BOOST_TEST_MODULE "interpreter Unit Tests"
+#include "interpreter.h"
+
+#include "cmdload.h"
+
+#include <boost/test/unit_test.hpp>
+
+/**
+ * A private command list in place of the one booted from commands.def
+ */
+struct CommandListFixture
+{
+    CommandListFixture()
+    {
+        saved = g_cmdlist;
+        for (int i = 0; i < 4; i++)
+        {
+            cmds[i] = command_info{};
+            cmds[i].cmd_str = const_cast<char *>(names[i]);
+            cmds[i].next = (i < 3) ? &cmds[i + 1] : nullptr;
+        }
+        g_cmdlist = &cmds[0];
+    }
+
+    ~CommandListFixture() { g_cmdlist = saved; }
+
+    command_info *saved;
+    command_info cmds[4];
+    const char *names[4] = {"look", "kill", "who", "save"};
+};
+
+BOOST_FIXTURE_TEST_SUITE(interpreter_cpp_tests, CommandListFixture)
+
+BOOST_AUTO_TEST_CASE(command_stats_top_test)
+{
+    cmds[0].stats.calls = 10;
+    cmds[0].stats.total_usec = 500;
+    cmds[1].stats.calls = 1;
+    cmds[1].stats.total_usec = 9000;
+    cmds[3].stats.calls = 3;
+    cmds[3].stats.total_usec = 2000;
+
+    // Unused commands are left out, the rest sorted by total time
+    auto top = command_stats_top(10);
+    BOOST_TEST(top.size() == 3U);
+    BOOST_TEST(top[0] == &cmds[1]);
+    BOOST_TEST(top[1] == &cmds[3]);
+    BOOST_TEST(top[2] == &cmds[0]);
+
+    top = command_stats_top(1);
+    BOOST_TEST(top.size() == 1U);
+    BOOST_TEST(top[0] == &cmds[1]);
+
+    command_stats_clear();
+    BOOST_TEST(command_stats_top(10).empty());
+    BOOST_TEST(cmds[1].stats.total_usec == 0U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,173 @@
+#define BOOST_TEST_MODULE "mobact Unit Tests"
+#include "mobact.h"
+
+#include "FixtureBase.h"
+#include "config.h"
+#include "destruct.h"
+#include "dil.h"
+#include "dilrun.h"
+#include "file_index_type.h"
+#include "files.h"
+#include "handler.h"
+#include "main_functions.h"
+#include "textutil.h"
+#include "unit_data.h"
+#include "zone_type.h"
+
+#include <filesystem>
+#include <map>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+/**
+ * Objects in the unit list, each with a ticking function that is never
+ * run. All of them are started in the same tic, like after a zone reset.
+ */
+struct MobactFixture : public unit_tests::FixtureBase
+{
+    MobactFixture()
+        : FixtureBase()
+        , zone("mobact")
+        , fi(&zone, "ticker", UNIT_ST_OBJ)
+    {
+    }
+
+    ~MobactFixture() override
+    {
+        for (auto *u : units)
+        {
+            stop_all_special(u);
+            remove_from_unit_list(u);
+            delete u;
+        }
+
+        // Let the cancelled events drain
+        for (int i = 0; i < 2 * HEART_BEAT; i++)
+        {
+            g_tics++;
+            g_events.process();
+        }
+        clear_destructed();
+    }
+
+    void add(int n)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            unit_data *u = new_unit_data(UNIT_ST_OBJ, nullptr);
+            u->setFileIndex(&fi);
+            insert_in_unit_list(u);
+            create_fptr(u, 0, FN_PRI_CHORES, HEART_BEAT, SFB_TICK, nullptr);
+            units.push_back(u);
+        }
+    }
+
+    /// Number of heartbeats due in each tic
+    std::map<int, int> due()
+    {
+        std::map<int, int> tics;
+
+        for (auto *u : units)
+        {
+            tics[u->getFunctionPointer()->getEventQueue()->when]++;
+        }
+        return tics;
+    }
+
+    /// Heartbeats counted in the coming tics
+    static int counted()
+    {
+        int load[2 * HEART_BEAT];
+        int total = 0;
+
+        heartbeat_report(2 * HEART_BEAT, load);
+        for (int n : load)
+        {
+            total += n;
+        }
+        return total;
+    }
+
+    static constexpr int HEART_BEAT = 10 * PULSE_SEC;
+
+    zone_type zone;
+    file_index_type fi;
+    std::vector<unit_data *> units;
+};
+
+BOOST_FIXTURE_TEST_SUITE(mobact_cpp_tests, MobactFixture)
+
+BOOST_AUTO_TEST_CASE(spread_test)
+{
+    add(72);
+
+    // Spread over the due tic and the PULSE_SEC tics on either side of it
+    auto tics = due();
+    BOOST_TEST(tics.size() == 2U * PULSE_SEC + 1);
+    BOOST_TEST(tics.begin()->first == g_tics + HEART_BEAT - PULSE_SEC);
+    BOOST_TEST(tics.rbegin()->first == g_tics + HEART_BEAT + PULSE_SEC);
+    for (auto &t : tics)
+    {
+        BOOST_TEST(t.second == 72 / (2 * PULSE_SEC + 1));
+    }
+
+    int load[HEART_BEAT + PULSE_SEC];
+    heartbeat_report(HEART_BEAT + PULSE_SEC, load);
+    BOOST_TEST(load[HEART_BEAT - 1] == 8);
+    BOOST_TEST(load[HEART_BEAT - PULSE_SEC - 2] == 0);
+
+    // Stopped heartbeats are no longer counted
+    stop_special(units[0], units[0]->getFunctionPointer());
+    heartbeat_report(HEART_BEAT + PULSE_SEC, load);
+    int total = 0;
+    for (int n : load)
+    {
+        total += n;
+    }
+    BOOST_TEST(total == 71);
+}
+
+BOOST_AUTO_TEST_CASE(dephase_test)
+{
+    add(2 * (HEART_BEAT - 1));
+
+    heartbeat_dephase();
+
+    // Every tic of the first period gets its share
+    auto tics = due();
+    BOOST_TEST(tics.size() == HEART_BEAT - 1U);
+    BOOST_TEST(tics.begin()->first == g_tics + 1);
+    for (auto &t : tics)
+    {
+        BOOST_TEST(t.second == 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(loadtime_activate_test)
+{
+    add(1);
+
+    // A DIL copied onto a unit by a zone reset, its template doesn't exist
+    unit_data *u = new_unit_data(UNIT_ST_OBJ, nullptr);
+    u->setFileIndex(&fi);
+    insert_in_unit_list(u);
+    units.push_back(u);
+
+    dilargstype *dilargs = nullptr;
+    CREATE(dilargs, dilargstype, 1);
+    dilargs->name = str_dup("nosuch@mobact");
+    create_fptr(u, SFUN_DILCOPY_INTERNAL, 0, HEART_BEAT, SFB_TICK, dilargs);
+    BOOST_TEST(counted() == 2);
+
+    // The pending beat is run now, and no longer counted
+    dil_loadtime_activate(u);
+    BOOST_TEST(u->getFunctionPointer() == nullptr);
+    BOOST_TEST(counted() == 1);
+
+    std::string err = g_cServerConfig.getZoneDir() + "mobact.err";
+    fclose_cache(err.c_str());
+    std::filesystem::remove(err);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,155 @@
+#define BOOST_TEST_MODULE "network Unit Tests"
+#include "network.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace mplex;
+
+static ubit32 addr(const char *ip)
+{
+    return inet_addr(ip);
+}
+
+/// Non blocking connect to the mother port on loopback
+static int connect_client(int nPort)
+{
+    sockaddr_in sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sa.sin_port = htons(nPort);
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    BOOST_REQUIRE(fd >= 0);
+    BOOST_REQUIRE(fcntl(fd, F_SETFL, O_NONBLOCK) == 0);
+    int n = connect(fd, (sockaddr *)&sa, sizeof(sa));
+    BOOST_REQUIRE(n == 0 || errno == EINPROGRESS);
+    return fd;
+}
+
+BOOST_AUTO_TEST_SUITE(network_cpp_tests)
+
+BOOST_AUTO_TEST_CASE(admission_test)
+{
+    cAdmission a;
+
+    // No rate means no limit
+    for (int i = 0; i < 100; i++)
+    {
+        BOOST_TEST(a.Admit(addr("10.0.0.1"), 1000));
+    }
+
+    // Burst of three, then one every 30 seconds
+    a.SetRate(2, 3);
+    BOOST_TEST(a.Admit(addr("10.0.0.1"), 1000));
+    BOOST_TEST(a.Admit(addr("10.0.0.1"), 1000));
+    BOOST_TEST(a.Admit(addr("10.0.0.1"), 1000));
+    BOOST_TEST(!a.Admit(addr("10.0.0.1"), 1000));
+    BOOST_TEST(!a.Admit(addr("10.0.0.1"), 1029));
+    BOOST_TEST(a.Admit(addr("10.0.0.1"), 1030));
+    BOOST_TEST(!a.Admit(addr("10.0.0.1"), 1030));
+
+    // Other addresses have buckets of their own, loopback has none
+    BOOST_TEST(a.Admit(addr("10.0.0.2"), 1030));
+    for (int i = 0; i < 100; i++)
+    {
+        BOOST_TEST(a.Admit(addr("127.0.0.1"), 1030));
+    }
+    BOOST_TEST(a.Count() == 2);
+
+    // Refills up to the burst and no further
+    for (int i = 0; i < 3; i++)
+    {
+        BOOST_TEST(a.Admit(addr("10.0.0.1"), 5000));
+    }
+    BOOST_TEST(!a.Admit(addr("10.0.0.1"), 5000));
+}
+
+/*
+ * Measures only how fast a storm of connections is drained from the
+ * backlog and gets its banner. Every client connects from loopback, which
+ * admission never refuses, so refusals are left to admission_test.
+ */
+BOOST_AUTO_TEST_CASE(connection_storm_test)
+{
+    // Two descriptors per connection, stay well within the limit
+    rlimit rl;
+    BOOST_REQUIRE(getrlimit(RLIMIT_NOFILE, &rl) == 0);
+    int nClients = std::min<int>(2000, ((int)rl.rlim_cur - 64) / 2);
+    BOOST_REQUIRE(nClients > 0);
+
+    int fdMother = OpenMother(0, nClients);
+    sockaddr_in sa;
+    socklen_t size = sizeof(sa);
+    BOOST_REQUIRE(getsockname(fdMother, (sockaddr *)&sa, &size) == 0);
+    int nPort = ntohs(sa.sin_port);
+
+    cAdmission admission; // No rate set, admits everybody
+
+    const char banner[] = "Welcome to the test\n";
+    std::vector<int> clients;
+    std::vector<int> accepted;
+    auto fBanner = [&](int fd, const sockaddr_in &) {
+        BOOST_REQUIRE(write(fd, banner, sizeof(banner) - 1) == (ssize_t)(sizeof(banner) - 1));
+        accepted.push_back(fd);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Everybody knocks at once, the mother is only serviced now and then
+    for (int i = 0; i < nClients; i++)
+    {
+        clients.push_back(connect_client(nPort));
+        if (i % 250 == 249)
+        {
+            int n = AcceptAll(fdMother, admission, fBanner);
+            BOOST_TEST(n > 1);
+        }
+    }
+
+    int nBanners = 0;
+    std::vector<bool> done(clients.size(), false);
+    auto deadline = start + std::chrono::seconds(30);
+
+    while (nBanners < nClients && std::chrono::steady_clock::now() < deadline)
+    {
+        AcceptAll(fdMother, admission, fBanner);
+
+        for (size_t i = 0; i < clients.size(); i++)
+        {
+            char buf[64];
+            if (!done[i] && read(clients[i], buf, sizeof(buf)) == (ssize_t)(sizeof(banner) - 1))
+            {
+                done[i] = true;
+                nBanners++;
+            }
+        }
+    }
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    BOOST_TEST_MESSAGE(nClients << " connections got their banner in " << ms << " ms");
+
+    BOOST_TEST(nBanners == nClients);
+    BOOST_TEST((int)accepted.size() == nClients);
+
+    for (int fd : clients)
+    {
+        close(fd);
+    }
+    for (int fd : accepted)
+    {
+        close(fd);
+    }
+    close(fdMother);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,68 @@
+#define BOOST_TEST_MODULE "path Unit Tests"
+#include "path.h"
+
+#include <tuple>
+
+#include <boost/test/unit_test.hpp>
+
+/**
+ * Build a component graph from (from, to, weight, direction) edges.
+ */
+static graph_t make_graph(int vertices, std::initializer_list<std::tuple<int, int, int, int>> edges)
+{
+    graph_t g(vertices);
+    auto dir = get(boost::edge_dir, g);
+
+    for (auto &e : edges)
+    {
+        auto ed = add_edge(std::get<0>(e), std::get<1>(e), std::get<2>(e), g).first;
+        dir[ed] = std::get<3>(e);
+    }
+
+    return g;
+}
+
+BOOST_AUTO_TEST_SUITE(path_cpp_tests)
+
+BOOST_AUTO_TEST_CASE(first_hops_test)
+{
+    //  0 -north-> 1 -east-> 2 -up-> 3
+    //  0 -south-> 4 --------------> 3  (cheaper)
+    graph_t g = make_graph(6,
+                           {{0, 1, 1, DIR_NORTH},
+                            {1, 2, 1, DIR_EAST},
+                            {2, 3, 1, DIR_UP},
+                            {0, 4, 1, DIR_SOUTH},
+                            {4, 3, 1, DIR_ENTER},
+                            {1, 0, 1, DIR_SOUTH},
+                            {3, 5, 1, DIR_DOWN}});
+
+    auto hops = create_first_hops(g, 0);
+
+    BOOST_TEST(hops.size() == 6U);
+    BOOST_TEST(hops[0] == DIR_HERE);
+    BOOST_TEST(hops[1] == DIR_NORTH);
+    BOOST_TEST(hops[2] == DIR_NORTH);
+    BOOST_TEST(hops[3] == DIR_SOUTH);
+    BOOST_TEST(hops[4] == DIR_SOUTH);
+    BOOST_TEST(hops[5] == DIR_SOUTH);
+
+    // Nothing leads back from 5
+    hops = create_first_hops(g, 5);
+    BOOST_TEST(hops[5] == DIR_HERE);
+    BOOST_TEST(hops[0] == DIR_IMPOSSIBLE);
+    BOOST_TEST(hops[3] == DIR_IMPOSSIBLE);
+}
+
+BOOST_AUTO_TEST_CASE(first_hops_weight_test)
+{
+    // The direct door is expensive, going round is cheaper
+    graph_t g = make_graph(3, {{0, 1, 100, DIR_EAST}, {0, 2, 1, DIR_NORTH}, {2, 1, 1, DIR_SOUTHEAST}});
+
+    auto hops = create_first_hops(g, 0);
+
+    BOOST_TEST(hops[1] == DIR_NORTH);
+    BOOST_TEST(hops[2] == DIR_NORTH);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
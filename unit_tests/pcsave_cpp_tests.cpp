@@ -0,0 +1,137 @@
+#define BOOST_TEST_MODULE "pcsave Unit Tests"
+#include "pcsave.h"
+
+#include "FixtureBase.h"
+#include "config.h"
+#include "db.h"
+#include "files.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+/**
+ * A player directory in a scratch directory, which is entered so the
+ * configured directories (relative to the bin directory) are inside it.
+ * Holds the players Alice (id 11) and Bob (id 12), Bob's inventory and
+ * a player file too short to hold an id.
+ */
+struct PlayerIndexFixture : public unit_tests::FixtureBase
+{
+    PlayerIndexFixture()
+        : FixtureBase()
+    {
+        char tmpl[] = "/tmp/vme_pcsave_XXXXXX";
+        BOOST_REQUIRE(mkdtemp(tmpl) != nullptr);
+        scratch = tmpl;
+        std::filesystem::create_directories(scratch / "bin");
+        cwd = std::filesystem::current_path();
+        std::filesystem::current_path(scratch / "bin");
+        if (!g_cServerConfig.getLibDir().empty())
+        {
+            std::filesystem::create_directories(g_cServerConfig.getLibDir());
+        }
+        for (const char *letter : {"a", "b", "c"})
+        {
+            std::filesystem::create_directories(g_cServerConfig.getPlyDir() + letter);
+        }
+        player_id = g_player_id;
+
+        write_player("alice", 11);
+        write_player("bob", 12);
+        write_player("bob.inv", 13);
+        fclose(fopen(PlayerFileName("carl").c_str(), "wb"));
+
+        player_file_index();
+    }
+
+    ~PlayerIndexFixture() override
+    {
+        fclose_cache(g_cServerConfig.getFileInLibDir(PLAYER_ID_NAME).c_str());
+        g_player_id = player_id;
+        std::filesystem::current_path(cwd);
+        std::filesystem::remove_all(scratch);
+    }
+
+    static void write_player(const char *name, sbit32 id)
+    {
+        ubit8 ply[4] = {0, 0, 0, 0};
+
+        FILE *f = fopen(PlayerFileName(name).c_str(), "wb");
+        BOOST_REQUIRE(f);
+        int len = sizeof(ply);
+        fwrite(&id, sizeof(id), 1, f);
+        fwrite(&len, sizeof(len), 1, f);
+        fwrite(ply, sizeof(ply), 1, f);
+        fclose(f);
+    }
+
+    std::filesystem::path scratch;
+    std::filesystem::path cwd;
+    sbit32 player_id;
+};
+
+BOOST_FIXTURE_TEST_SUITE(pcsave_cpp_tests, PlayerIndexFixture)
+
+BOOST_AUTO_TEST_CASE(index_build_test)
+{
+    char alice[] = "Alice";
+    char bob[] = "bob";
+
+    BOOST_TEST(player_exists("alice"));
+    BOOST_TEST(player_exists("ALICE"));
+    BOOST_TEST(find_player_id(alice) == 11);
+    BOOST_TEST(find_player_id(bob) == 12);
+
+    // Inventories and files without an id are not players
+    BOOST_TEST(!player_exists("bob.inv"));
+    BOOST_TEST(!player_exists("carl"));
+}
+
+BOOST_AUTO_TEST_CASE(index_save_test)
+{
+    char cecilie[] = "Cecilie";
+    ubit8 ply[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    BOOST_TEST(!player_exists("cecilie"));
+    save_player_disk("Cecilie", nullptr, 42, sizeof(ply), ply);
+    BOOST_TEST(player_exists("cecilie"));
+    BOOST_TEST(find_player_id(cecilie) == 42);
+    BOOST_TEST(file_exists(PlayerFileName("cecilie")));
+
+    // Saved again under a new id
+    save_player_disk("cecilie", nullptr, 43, sizeof(ply), ply);
+    BOOST_TEST(find_player_id(cecilie) == 43);
+}
+
+BOOST_AUTO_TEST_CASE(index_delete_test)
+{
+    char alice[] = "alice";
+
+    BOOST_TEST(delete_player("Alice"));
+    BOOST_TEST(!player_exists("alice"));
+    BOOST_TEST(find_player_id(alice) == -1);
+    BOOST_TEST(!file_exists(PlayerFileName("alice")));
+
+    // Nothing to delete, the index is unchanged
+    BOOST_TEST(!delete_player("alice"));
+    BOOST_TEST(player_exists("bob"));
+}
+
+BOOST_AUTO_TEST_CASE(index_missing_test)
+{
+    char nobody[] = "nobody";
+
+    BOOST_TEST(!player_exists("nobody"));
+    BOOST_TEST(find_player_id(nobody) == -1);
+
+    // The index is asked, not the disk
+    write_player("anna", 14);
+    BOOST_TEST(!player_exists("anna"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
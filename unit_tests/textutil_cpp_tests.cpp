@@ -0,0 +1,294 @@
+#define BOOST_TEST_MODULE "textutil Unit Tests"
+#include "textutil.h"
+
+#include <cctype>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+using cstring_ptr = std::unique_ptr<char, decltype(free) *>;
+
+/**********************************************************************************
+ * Reference implementations
+ *
+ * These are the byte-at-a-time versions of str_correct_utf8() and html_encode_utf8()
+ * that the word-at-a-time fast paths replaced. The fuzz tests below require the
+ * production functions to give byte for byte identical output.
+ */
+namespace reference
+{
+#define UTF8_ACCEPT 0
+#define UTF8_REJECT 1
+
+static const uint8_t utf8d[] = {
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, // 00..1f
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, // 20..3f
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, // 40..5f
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, // 60..7f
+    1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+    9,   9,   9,   9,   9,   9,   9,   9,   9,   9,   9,   9,   9,   9,   9,   9, // 80..9f
+    7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,
+    7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7, // a0..bf
+    8,   8,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+    2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   // c0..df
+    0xa, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x4, 0x3, 0x3, // e0..ef
+    0xb, 0x6, 0x6, 0x6, 0x5, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, // f0..ff
+    0x0, 0x1, 0x2, 0x3, 0x5, 0x8, 0x7, 0x1, 0x1, 0x1, 0x4, 0x6, 0x1, 0x1, 0x1, 0x1, // s0..s0
+    1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+    1,   0,   1,   1,   1,   1,   1,   0,   1,   0,   1,   1,   1,   1,   1,   1, // s1..s2
+    1,   2,   1,   1,   1,   1,   1,   2,   1,   2,   1,   1,   1,   1,   1,   1,
+    1,   1,   1,   1,   1,   1,   1,   2,   1,   1,   1,   1,   1,   1,   1,   1, // s3..s4
+    1,   2,   1,   1,   1,   1,   1,   1,   1,   2,   1,   1,   1,   1,   1,   1,
+    1,   1,   1,   1,   1,   1,   1,   3,   1,   3,   1,   1,   1,   1,   1,   1, // s5..s6
+    1,   3,   1,   1,   1,   1,   1,   3,   1,   3,   1,   1,   1,   1,   1,   1,
+    1,   3,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1, // s7..s8
+};
+
+ubit32 utf8_decode(ubit32 *state, ubit32 *codep, ubit8 byte)
+{
+    ubit32 type = utf8d[byte];
+
+    *codep = (*state != UTF8_ACCEPT) ? (byte & 0x3fu) | (*codep << 6) : (0xff >> type) & (byte);
+    *state = utf8d[256 + *state * 16 + type];
+
+    return *state;
+}
+
+void str_correct_utf8(std::string &str)
+{
+    ubit32 codepoint = 0;
+    ubit32 prev = 0;
+    ubit32 current = 0;
+    char *src = (char *)str.c_str();
+    char *s = src;
+
+    for (; *s; prev = current, s++)
+    {
+        if (utf8_decode(&current, &codepoint, *s) == UTF8_REJECT)
+        {
+            *s = '?';
+            current = UTF8_ACCEPT;
+            if (prev != UTF8_ACCEPT)
+            {
+                s--;
+                *s = '?';
+                if (s >= src)
+                {
+                    s--;
+                }
+                if (s >= src)
+                {
+                    s--;
+                }
+            }
+        }
+    }
+}
+
+std::string html_encode_utf8(const char *src)
+{
+    int nLen = strlen(src);
+    std::string sBuffer;
+    int pos = 0;
+
+    while (isspace(src[pos]))
+    {
+        pos++;
+    }
+
+    for (; pos < nLen; ++pos)
+    {
+        if ((src[pos] & 0x80) == 0)
+        {
+            if (src[pos] < 32)
+            {
+                continue;
+            }
+
+            switch (src[pos])
+            {
+                case ' ':
+                {
+                    sBuffer.append(" ");
+                    while (isspace(src[pos + 1]))
+                    {
+                        pos++;
+                    }
+                    continue;
+                }
+                case '&':
+                    sBuffer.append("&amp;");
+                    continue;
+                case '\"':
+                    sBuffer.append("&quot;");
+                    continue;
+                case '<':
+                    sBuffer.append("&lt;");
+                    continue;
+                case '>':
+                    sBuffer.append("&gt;");
+                    continue;
+            }
+            sBuffer.append(&src[pos], 1);
+            continue;
+        }
+        else if ((src[pos] & 0xE0) == 0xC0)
+        {
+            if (pos + 1 < nLen)
+            {
+                sBuffer.append(&src[pos], 2);
+                pos += 1;
+                continue;
+            }
+            sBuffer.append(&src[pos], 1);
+        }
+        else if ((src[pos] & 0xF0) == 0xE0)
+        {
+            if (pos + 2 < nLen)
+            {
+                sBuffer.append(&src[pos], 3);
+                pos += 2;
+                continue;
+            }
+            sBuffer.append(&src[pos], 1);
+        }
+        else if ((src[pos] & 0xF8) == 0xF0)
+        {
+            if (pos + 3 < nLen)
+            {
+                sBuffer.append(&src[pos], 4);
+                pos += 3;
+                continue;
+            }
+            sBuffer.append(&src[pos], 1);
+        }
+        else
+        {
+            sBuffer.append("?");
+        }
+    }
+
+    return sBuffer;
+}
+
+#undef UTF8_ACCEPT
+#undef UTF8_REJECT
+} // namespace reference
+
+/**
+ * Generates NUL free strings that mix long ASCII runs, HTML special characters,
+ * whitespace, valid multi-byte sequences and random (often invalid) high bytes.
+ */
+static std::string random_input(std::mt19937 &rng)
+{
+    static const char *fragments[] = {"The quick brown fox ",
+                                      "jumps over the lazy dog",
+                                      "&",
+                                      "\"",
+                                      "<b>",
+                                      " ",
+                                      "   ",
+                                      "\t",
+                                      "\r\n",
+                                      "\xc3\xa6",
+                                      "\xe2\x82\xac",
+                                      "\xf0\x9f\x98\x80",
+                                      "\xed\xa0\x80",
+                                      "\xc0\xaf"};
+    std::uniform_int_distribution<int> nfrag(0, 40);
+    std::uniform_int_distribution<int> kind(0, 3);
+    std::uniform_int_distribution<int> pick(0, sizeof(fragments) / sizeof(fragments[0]) - 1);
+    std::uniform_int_distribution<int> byte(1, 255);
+    std::uniform_int_distribution<int> ascii(32, 126);
+
+    std::string str;
+    for (int i = nfrag(rng); i > 0; i--)
+    {
+        switch (kind(rng))
+        {
+            case 0:
+                str += fragments[pick(rng)];
+                break;
+            case 1:
+                str += (char)byte(rng);
+                break;
+            default:
+                for (int j = ascii(rng) % 20; j > 0; j--)
+                {
+                    str += (char)ascii(rng);
+                }
+                break;
+        }
+    }
+
+    return str;
+}
+
+BOOST_AUTO_TEST_SUITE(textutil_cpp_tests)
+
+BOOST_AUTO_TEST_CASE(html_encode_utf8_basic_test)
+{
+    cstring_ptr result(html_encode_utf8("  say  <b>\"Hi\"</b> & \xc3\xa6\xc3\xb8\xc3\xa5 "), free);
+    BOOST_TEST(std::string(result.get()) == "say &lt;b&gt;&quot;Hi&quot;&lt;/b&gt; &amp; \xc3\xa6\xc3\xb8\xc3\xa5 ");
+
+    BOOST_TEST(html_encode_utf8(nullptr) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(str_correct_utf8_basic_test)
+{
+    std::string str{"plain ascii text that is longer than a word \xc3\xa6 ok \xff done"};
+    str_correct_utf8(str);
+    BOOST_TEST(str == "plain ascii text that is longer than a word \xc3\xa6 ok ? done");
+}
+
+BOOST_AUTO_TEST_CASE(hashcompare_test)
+{
+    BOOST_TEST(hashcompare("Zq3xY9", "Zq3xY9") == 0);
+    BOOST_TEST(hashcompare("Zq3xY9", "Zq3xY8") == 1);
+    BOOST_TEST(hashcompare("Zq3xY9", "zq3xY9") == 1);
+
+    // Unlike pwdcompare a prefix is no match, whichever way round
+    BOOST_TEST(hashcompare("Zq3xY9", "Zq3x") == 1);
+    BOOST_TEST(hashcompare("Zq3x", "Zq3xY9") == 1);
+    BOOST_TEST(hashcompare("Zq3xY9", "") == 1);
+    BOOST_TEST(hashcompare("", "") == 0);
+    BOOST_TEST(hashcompare(nullptr, "Zq3xY9") == 1);
+    BOOST_TEST(hashcompare("Zq3xY9", nullptr) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(html_encode_utf8_fuzz_test)
+{
+    std::mt19937 rng(76);
+
+    for (int i = 0; i < 20000; i++)
+    {
+        std::string input = random_input(rng);
+        cstring_ptr result(html_encode_utf8(input.c_str()), free);
+        std::string expected = reference::html_encode_utf8(input.c_str());
+        BOOST_REQUIRE_MESSAGE(expected == result.get(), "html_encode_utf8 mismatch on input [" << input << "]");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(str_correct_utf8_fuzz_test)
+{
+    std::mt19937 rng(77);
+
+    for (int i = 0; i < 20000; i++)
+    {
+        std::string input = random_input(rng);
+        std::string result = input;
+        std::string expected = input;
+        str_correct_utf8(result);
+        reference::str_correct_utf8(expected);
+        BOOST_REQUIRE_MESSAGE(expected == result, "str_correct_utf8 mismatch on input [" << input << "]");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
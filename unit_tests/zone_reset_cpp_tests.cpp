@@ -0,0 +1,171 @@
+#define BOOST_TEST_MODULE "zone_reset Unit Tests"
+#include "zone_reset.h"
+
+#include "FixtureBase.h"
+#include "main_functions.h"
+#include "zone_reset_cmd.h"
+#include "zone_type.h"
+
+#include <sys/time.h>
+
+#include <map>
+
+#include <boost/test/unit_test.hpp>
+
+extern unit_data *(*exec_zone_cmd[])(unit_data *, zone_reset_cmd *);
+
+namespace
+{
+std::map<zone_reset_cmd *, int> runs;
+
+/// A NOP that counts its runs and takes 2ms, so a 5ms tic budget is spent after three
+unit_data *slow_nop(unit_data *u, zone_reset_cmd *cmd)
+{
+    timeval start;
+    timeval now;
+
+    runs[cmd]++;
+    gettimeofday(&start, nullptr);
+    do
+    {
+        gettimeofday(&now, nullptr);
+    } while ((now.tv_sec - start.tv_sec) * 1000000L + (now.tv_usec - start.tv_usec) < 2000);
+
+    return nullptr;
+}
+} // namespace
+
+/**
+ * A zone with ten top level NOPs, each too slow for more than a few of
+ * them to run in the reset budget of one tic.
+ */
+struct ZoneResetFixture : public unit_tests::FixtureBase
+{
+    ZoneResetFixture()
+        : FixtureBase()
+        , zone("zonereset")
+    {
+        nop = exec_zone_cmd[0];
+        exec_zone_cmd[0] = slow_nop;
+        runs.clear();
+        zone.setZoneResetCommands(commands(10));
+    }
+
+    ~ZoneResetFixture() override
+    {
+        exec_zone_cmd[0] = nop;
+
+        // Let a pending slice see the reset is gone
+        zone.setZoneResetNext(nullptr);
+        g_tics++;
+        g_events.process();
+    }
+
+    static zone_reset_cmd *commands(int n)
+    {
+        zone_reset_cmd *first = nullptr;
+
+        for (int i = 0; i < n; i++)
+        {
+            auto *cmd = new zone_reset_cmd();
+            cmd->setCommandNum(0);
+            cmd->setNextPtr(first);
+            first = cmd;
+        }
+        return first;
+    }
+
+    /// Run slices until the reset is done, returns the number of slices
+    int run_sliced()
+    {
+        int slices = 1;
+
+        g_tics++;
+        zone.setZoneResetNext(zone.getZoneResetCommands());
+        zone_reset_event(&zone, nullptr);
+        while (zone.getZoneResetNext())
+        {
+            slices++;
+            g_tics++;
+            g_events.process();
+        }
+        return slices;
+    }
+
+    /// Each command of the zone has run 'n' times
+    bool all_ran(int n)
+    {
+        for (zone_reset_cmd *cmd = zone.getZoneResetCommands(); cmd; cmd = cmd->getNext())
+        {
+            if (runs[cmd] != n)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    unit_data *(*nop)(unit_data *, zone_reset_cmd *);
+    zone_type zone;
+};
+
+BOOST_FIXTURE_TEST_SUITE(zone_reset_cpp_tests, ZoneResetFixture)
+
+BOOST_AUTO_TEST_CASE(sliced_reset_runs_all_once_test)
+{
+    int slices = run_sliced();
+
+    BOOST_TEST(slices >= 4);
+    BOOST_TEST(runs.size() == 10);
+    BOOST_TEST(all_ran(1));
+
+    // No slice is left queued
+    g_tics++;
+    g_events.process();
+    BOOST_TEST(all_ran(1));
+}
+
+BOOST_AUTO_TEST_CASE(full_reset_ends_sliced_test)
+{
+    g_tics++;
+    zone.setZoneResetNext(zone.getZoneResetCommands());
+    zone_reset_event(&zone, nullptr);
+    BOOST_REQUIRE(zone.getZoneResetNext() != nullptr);
+    size_t done = runs.size();
+
+    zone_reset(&zone);
+    BOOST_TEST(zone.getZoneResetNext() == nullptr);
+
+    // The queued slice does nothing, so the started commands ran twice
+    g_tics++;
+    g_events.process();
+    int twice = 0;
+    for (auto &run : runs)
+    {
+        BOOST_TEST((run.second == 1 || run.second == 2));
+        twice += run.second == 2;
+    }
+    BOOST_TEST(twice == (int)done);
+}
+
+BOOST_AUTO_TEST_CASE(new_commands_end_sliced_test)
+{
+    g_tics++;
+    zone.setZoneResetNext(zone.getZoneResetCommands());
+    zone_reset_event(&zone, nullptr);
+    BOOST_REQUIRE(zone.getZoneResetNext() != nullptr);
+
+    zone.setZoneResetCommands(commands(10));
+    BOOST_TEST(zone.getZoneResetNext() == nullptr);
+
+    // The queued slice does not touch the freed commands
+    runs.clear();
+    g_tics++;
+    g_events.process();
+    BOOST_TEST(runs.empty());
+
+    BOOST_TEST(run_sliced() >= 4);
+    BOOST_TEST(all_ran(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -8,6 +8,7 @@
 #include "comm.h"
 #include "dbfind.h"
 #include "dilrun.h"
+#include "dilstring.h"
 #include "formatter.h"
 #include "interpreter.h"
 #include "system.h"
@@ -468,7 +469,7 @@ void do_change(unit_data *ch, char *arg, const command_info *cmd)
             if (prg)
             {
                 prg->waitcmd = WAITCMD_MAXINST - 1; // The usual hack, see db_file
-                prg->fp->vars[0].val.string = str_dup(org_arg);
+                prg->fp->vars[0].val.string = dilstr_new(org_arg);
                 dil_activate(prg);
             }
             break;
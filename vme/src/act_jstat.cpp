@@ -467,6 +467,43 @@ static void stat_global_dil(unit_data *ch, ubit32 nCount)
     send_json_to_client(buffer.GetString(), const_cast<descriptor_data *>(CHAR_DESCRIPTOR(ch)));
 }
 
+static void stat_global_cmd(unit_data *ch, char *arg)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+
+    arg = (char *)skip_spaces(arg);
+    int nCount = str_is_empty(arg) ? 20 : atoi(arg);
+
+    writer.StartObject();
+    {
+        writer.String("command_stats");
+        writer.StartArray();
+        for (auto *cmd : command_stats_top(MAX(nCount, 1)))
+        {
+            const command_stats &st = cmd->stats;
+
+            writer.StartObject();
+            json::write_kvp("command", cmd->cmd_str, writer);
+            json::write_kvp("calls", st.calls, writer);
+            json::write_kvp("total_usec", st.total_usec, writer);
+            json::write_kvp("max_usec", st.max_usec, writer);
+            writer.String("histogram");
+            writer.StartArray();
+            for (auto n : st.histogram)
+            {
+                writer.Uint(n);
+            }
+            writer.EndArray();
+            writer.EndObject();
+        }
+        writer.EndArray();
+    }
+    writer.EndObject();
+
+    send_json_to_client(buffer.GetString(), const_cast<descriptor_data *>(CHAR_DESCRIPTOR(ch)));
+}
+
 static void extra_stat_zone(unit_data *ch, char *arg, zone_type *zone)
 {
     char buf[MAX_STRING_LENGTH];
@@ -475,7 +512,7 @@ static void extra_stat_zone(unit_data *ch, char *arg, zone_type *zone)
 
     //  void stat_dijkstraa (class unit_data * ch, class zone_type *z);
 
-    static const char *zone_args[] = {"mobiles", "objects", "rooms", "reset", "errors", "info", "path", "dil", nullptr};
+    static const char *zone_args[] = {"mobiles", "objects", "rooms", "reset", "errors", "info", "path", "dil", "profile", nullptr};
 
     static int search_types[] = {UNIT_ST_NPC, UNIT_ST_OBJ, UNIT_ST_ROOM};
 
@@ -487,7 +524,7 @@ static void extra_stat_zone(unit_data *ch, char *arg, zone_type *zone)
         if ((zone = find_zone(buf)) == nullptr)
         {
             send_to_char("Usage: jstat zone [name] "
-                         "[mobiles|objects|rooms|reset|info|errors|path|dil]<br/>",
+                         "[mobiles|objects|rooms|reset|info|errors|path|dil|profile]<br/>",
                          ch);
             return;
         }
@@ -561,6 +598,13 @@ static void extra_stat_zone(unit_data *ch, char *arg, zone_type *zone)
                 stat_dil(ch, zone);
             }
             break;
+
+            case 8:
+            {
+                writer.String("dil_profile");
+                zone->getStatDILProfileJSON(writer);
+            }
+            break;
         }
     }
     writer.EndObject();
@@ -1262,7 +1306,8 @@ void do_jstat(unit_data *ch, char *argument, const command_info *cmd)
 
     if (str_is_empty(argument))
     {
-        send_to_char("Usage: See help jstat<br/>[room|zone|memory|account|creators|count [no]|world [dil (ms)|extra|zone]|unit-name]<br/>",
+        send_to_char("Usage: See help jstat<br/>"
+                     "[room|zone|memory|account|creators|count [no]|world [dil (ms)|cmd [no]|extra|zone]|unit-name]<br/>",
                      ch);
         return;
     }
@@ -1315,6 +1360,11 @@ void do_jstat(unit_data *ch, char *argument, const command_info *cmd)
             stat_global_dil(ch, i);
             return;
         }
+        else if (!strncmp("cmd", argument, 3))
+        {
+            stat_global_cmd(ch, argument + 3);
+            return;
+        }
         else
         {
             stat_world_extra(ch);
@@ -211,6 +211,48 @@ void do_shutdown(unit_data *ch, char *argument, const command_info *cmd)
     g_mud_shutdown = 1;
 }
 
+void do_reloadzone(unit_data *ch, char *argument, const command_info *cmd)
+{
+    char buf[MAX_INPUT_LENGTH];
+    zone_type *zone = nullptr;
+
+    if (!ch->isPC())
+    {
+        return;
+    }
+
+    if (cmd_is_abbrev(ch, cmd))
+    {
+        send_to_char("If you want to reload a zone - say so!<br/>", ch);
+        return;
+    }
+
+    one_argument(argument, buf);
+
+    if (str_is_empty(buf))
+    {
+        send_to_char("Reload which zone? Compile it first, the .data and .reset files are read.<br/>", ch);
+        return;
+    }
+
+    if ((zone = find_zone(buf)) == nullptr)
+    {
+        send_to_char("No such zone.<br/>", ch);
+        return;
+    }
+
+    std::string err = reload_zone(zone);
+
+    if (!err.empty())
+    {
+        act("Reload failed: $2t", eA_ALWAYS, ch, err.c_str(), cActParameter(), eTO_CHAR);
+        return;
+    }
+
+    slog(LOG_ALL, 0, "%s reloaded zone %s.", ch->getNames().Name(), zone->getName());
+    act("Zone $2t reloaded, see the zone log for any problems.", eA_ALWAYS, ch, zone->getName().c_str(), cActParameter(), eTO_CHAR);
+}
+
 void do_snoop(unit_data *ch, char *argument, const command_info *cmd)
 {
     unit_data *victim = nullptr;
@@ -10,4 +10,5 @@ void do_users(unit_data *, char *, const command_info *);
 void do_switch(unit_data *, char *, const command_info *);
 void do_timewarp(unit_data *, char *, const command_info *);
 void do_crash(unit_data *, char *, const command_info *);
+void do_reloadzone(unit_data *, char *, const command_info *);
 void do_wizlock(unit_data *, char *, const command_info *);
@@ -19,12 +19,14 @@
 #include "common.h"
 #include "constants.h"
 #include "db.h"
+#include "dilprofile.h"
 #include "dilshare.h"
 #include "files.h"
 #include "formatter.h"
 #include "handler.h"
 #include "interpreter.h"
 #include "main_functions.h"
+#include "mobact.h"
 #include "modify.h"
 #include "skills.h"
 #include "spec_assign.h"
@@ -44,6 +46,8 @@
 #include <arpa/inet.h>
 #include <netinet/in.h>
 
+#include <algorithm>
+#include <climits>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
@@ -115,6 +119,28 @@ static void stat_memory(unit_data *ch)
 
     msg = diku::format_to_str("Event queue Avg Process  ( Proceses/Sec ): %1.1f/%1.4f<br/>", g_events.Avg_PCount(), g_events.Avg_PTime());
     send_to_char(msg, ch);
+
+    // How evenly the heartbeats are spread over the coming tics
+    int load[10 * PULSE_SEC];
+    int nMin = INT_MAX;
+    int nMax = 0;
+    int nTotal = 0;
+
+    heartbeat_report(10 * PULSE_SEC, load);
+    msg = "Heartbeats per tic:";
+    for (int n : load)
+    {
+        msg += diku::format_to_str(" %d", n);
+        nMin = std::min(nMin, n);
+        nMax = std::max(nMax, n);
+        nTotal += n;
+    }
+    msg += diku::format_to_str("<br/>Heartbeats next %d tics: min %d, avg %1.1f, max %d<br/>",
+                               10 * PULSE_SEC,
+                               nMin,
+                               (float)nTotal / (10 * PULSE_SEC),
+                               nMax);
+    send_to_char(msg, ch);
     //  system_memory (ch);
     //  memory_status (buf);
     //  send_to_char (buf, ch);
@@ -268,7 +294,7 @@ static void stat_zone(unit_data *ch, zone_type *zone)
     auto msg = diku::format_to_str("Zone [%s]  Access [%d]<br/>"
                                    "Title: \"%s\"<br/>"
                                    "Load level [%d] Pay only [%d]<br/>"
-                                   "Number of Units [%d]    Number of Rooms [%d]<br/>"
+                                   "Number of Units [%d]    Number of Rooms [%d]    Players [%d]<br/>"
                                    "Reset Mode : %s (%d)    Reset Interval [%d]<br/>"
                                    "Pressure [%d] Change [%d] Sky [%d] Base [%d]<br/><br/>"
                                    "Authors Mud Mail: %s<br/><br/>%s<br/><br/>"
@@ -280,6 +306,7 @@ static void stat_zone(unit_data *ch, zone_type *zone)
                                    zone->getPayOnly(),
                                    zone->getNumOfFileIndexes(),
                                    zone->getNumOfRooms(),
+                                   zone->getNumOfPlayers(),
                                    reset_modes[reset_mode],
                                    reset_mode,
                                    zone->getZoneResetTime(),
@@ -357,6 +384,37 @@ static void stat_dil(unit_data *ch, zone_type *zone)
     send_to_char(msg, ch);
 }
 
+static void stat_dil_profile(unit_data *ch, char *arg, zone_type *zone)
+{
+    arg = (char *)skip_spaces(arg);
+
+    if (!strncmp("reset", arg, 5))
+    {
+        zone->resetDILProfile();
+        send_to_char("DIL profile cleared.<br/>", ch);
+        return;
+    }
+
+    auto msg = diku::format_to_str("<u>DIL profile of zone %s, one sample every %d instructions for the last %ld seconds",
+                                   zone->getName(),
+                                   DIL_PROFILE_INTERVAL,
+                                   (long)(time(nullptr) - zone->getDILProfileStart()));
+
+    if (!strncmp("folded", arg, 6))
+    {
+        msg += " (folded call stacks, samples):</u><br/>";
+        msg += zone->getStatDILProfile(true);
+    }
+    else
+    {
+        msg += " (samples, program:line):</u><br/><pre>";
+        msg += zone->getStatDILProfile(false);
+        msg += "</pre>";
+    }
+
+    page_string(CHAR_DESCRIPTOR(ch), msg);
+}
+
 static void stat_global_dil(unit_data *ch, ubit32 nCount)
 {
     auto msg = diku::format_to_str("<u>List of global DIL in all zones running for more than %dms:</u><br/>", nCount);
@@ -376,6 +434,47 @@ static void stat_global_dil(unit_data *ch, ubit32 nCount)
     send_to_char(msg, ch);
 }
 
+static void stat_global_cmd(unit_data *ch, char *arg)
+{
+    arg = (char *)skip_spaces(arg);
+
+    if (!strncmp("reset", arg, 5))
+    {
+        command_stats_clear();
+        send_to_char("Command statistics cleared.<br/>", ch);
+        return;
+    }
+
+    int nCount = str_is_empty(arg) ? 20 : atoi(arg);
+    auto top = command_stats_top(MAX(nCount, 1));
+
+    auto msg = diku::format_to_str("<u>Top %d commands by total time (runs, total ms, avg us, max us, "
+                                   "runs &lt;10us/&lt;100us/&lt;1ms/&lt;10ms/&lt;100ms/&lt;1s/&lt;10s/more):</u><br/><pre>",
+                                   (int)top.size());
+
+    for (auto *cmd : top)
+    {
+        const command_stats &st = cmd->stats;
+        msg += diku::format_to_str("%-15s %8u %10.1f %8llu %8u  %u/%u/%u/%u/%u/%u/%u/%u<br/>",
+                                   cmd->cmd_str,
+                                   st.calls,
+                                   st.total_usec / 1000.0,
+                                   (unsigned long long)(st.total_usec / st.calls),
+                                   st.max_usec,
+                                   st.histogram[0],
+                                   st.histogram[1],
+                                   st.histogram[2],
+                                   st.histogram[3],
+                                   st.histogram[4],
+                                   st.histogram[5],
+                                   st.histogram[6],
+                                   st.histogram[7]);
+    }
+
+    msg += "</pre>";
+    send_to_char(msg, ch);
+}
+
 static void extra_stat_zone(unit_data *ch, char *arg, zone_type *zone)
 {
     char buf[MAX_STRING_LENGTH];
@@ -384,7 +483,7 @@ static void extra_stat_zone(unit_data *ch, char *arg, zone_type *zone)
 
     //  void stat_dijkstraa (class unit_data * ch, class zone_type *z);
 
-    static const char *zone_args[] = {"mobiles", "objects", "rooms", "reset", "errors", "info", "path", "dil", nullptr};
+    static const char *zone_args[] = {"mobiles", "objects", "rooms", "reset", "errors", "info", "path", "dil", "profile", nullptr};
 
     static int search_types[] = {UNIT_ST_NPC, UNIT_ST_OBJ, UNIT_ST_ROOM};
 
@@ -396,7 +495,7 @@ static void extra_stat_zone(unit_data *ch, char *arg, zone_type *zone)
         if ((zone = find_zone(buf)) == nullptr)
         {
             send_to_char("Usage: wstat zone [name] "
-                         "[mobiles|objects|rooms|reset|info|errors|path|dil]<br/>",
+                         "[mobiles|objects|rooms|reset|info|errors|path|dil|profile]<br/>",
                          ch);
             return;
         }
@@ -461,6 +560,10 @@ static void extra_stat_zone(unit_data *ch, char *arg, zone_type *zone)
             stat_dil(ch, zone);
             break;
 
+        case 8:
+            stat_dil_profile(ch, arg, zone);
+            return;
+
         default:
             return;
     }
@@ -1291,7 +1394,8 @@ void do_wstat(unit_data *ch, char *argument, const command_info *cmd)
 
     if (str_is_empty(argument))
     {
-        send_to_char("Usage: See help wstat<br/>[room|zone|memory|account|creators|count <no>|world [dil (ms)|extra|zone]|unit-name]<br/>",
+        send_to_char("Usage: See help wstat<br/>"
+                     "[room|zone|memory|account|creators|count <no>|world [dil (ms)|cmd [no|reset]|extra|zone]|unit-name]<br/>",
                      ch);
         return;
     }
@@ -1344,6 +1448,11 @@ void do_wstat(unit_data *ch, char *argument, const command_info *cmd)
             stat_global_dil(ch, i);
             return;
         }
+        else if (!strncmp("cmd", argument, 3))
+        {
+            stat_global_cmd(ch, argument + 3);
+            return;
+        }
         else
         {
             stat_world_extra(ch);
@@ -17,6 +17,94 @@
 unit_affected_type *affected_list = nullptr; ///< Global list pointer
 unit_affected_type *next_affected_dude;      ///< dirty - very dirty indeed
 
+/*
+ * All affects on a unit with the same beat share one event in the event
+ * queue. The event is scheduled with the owner as arg1 and the beat as arg2,
+ * and every member affect points its event element at it. When the event
+ * fires, affect_beat() walks the owners affect list and ticks the members
+ * that are due, so the queue holds an event per unit and beat rather than
+ * per affect.
+ *
+ * Each affect remembers the tic its next tick is due, and the event fires
+ * at the earliest due tic of its members. An affect that joins a running
+ * beat out of step with it therefore still ticks on its own due tics, which
+ * keeps the number of ticks and the spacing between them unchanged.
+ */
+
+/**
+ * Remove af from its beat. When af was the last member the shared event is
+ * cancelled.
+ */
+static void affect_leave_beat(unit_affected_type *af)
+{
+    eventq_elem *event = af->getEventQueueElement();
+
+    if (event == nullptr)
+    {
+        return;
+    }
+
+    af->setEventQueueElement(nullptr);
+
+    for (unit_affected_type *i = af->getOwner()->getUnitAffected(); i; i = i->getNext())
+    {
+        if (i->getEventQueueElement() == event)
+        {
+            return;
+        }
+    }
+
+    event->func = nullptr;
+}
+
+/**
+ * Move the members of the beat 'event' on 'owner' to a new event in 'delay'
+ * tics, and cancel the old one.
+ */
+static void affect_move_beat(unit_data *owner, eventq_elem *event, int delay)
+{
+    eventq_elem *next_event = g_events.add(delay, affect_beat, event->arg1, event->arg2);
+
+    for (unit_affected_type *i = owner->getUnitAffected(); i; i = i->getNext())
+    {
+        if (i->getEventQueueElement() == event)
+        {
+            i->setEventQueueElement(next_event);
+        }
+    }
+
+    event->func = nullptr;
+}
+
+/**
+ * Add af to the beat of its owner matching af's beat, scheduling a new
+ * event if there is none. The first tick of af is due in 'delay' tics.
+ */
+static void affect_join_beat(unit_affected_type *af, int delay)
+{
+    unit_data *owner = af->getOwner();
+
+    affect_leave_beat(af);
+    af->setBeatDue(g_tics + delay);
+
+    for (unit_affected_type *i = owner->getUnitAffected(); i; i = i->getNext())
+    {
+        eventq_elem *event = i->getEventQueueElement();
+
+        if (i != af && event && event->func && event->arg2 == (void *)(intptr_t)af->getBeat())
+        {
+            af->setEventQueueElement(event);
+            if (event->when > af->getBeatDue())
+            {
+                affect_move_beat(owner, event, delay);
+            }
+            return;
+        }
+    }
+
+    af->setEventQueueElement(g_events.add(delay, affect_beat, (void *)owner, (void *)(intptr_t)af->getBeat()));
+}
+
 /**
  * Link an affected structure into the units affected structure
  */
@@ -94,11 +182,7 @@ void create_affect(unit_data *unit, unit_affected_type *af)
 
             if (af->getBeat() > 0)
             {
-                if (af->cgetEventQueueElement())
-                {
-                    g_events.remove(affect_beat, (void *)af, nullptr);
-                }
-                af->setEventQueueElement(g_events.add(af->getBeat(), affect_beat, (void *)af, nullptr));
+                affect_join_beat(af, af->getBeat());
             }
         }
         else
@@ -120,7 +204,7 @@ void unlink_affect(unit_affected_type *af)
     /* Affects may never be removed by lower function than this */
     af->register_destruct();
 
-    g_events.remove(affect_beat, (void *)af, nullptr);
+    affect_leave_beat(af);
 
     if (next_affected_dude == af)
     {
@@ -183,11 +267,7 @@ void destroy_affect(unit_affected_type *af)
             {
                 af->setDuration(0);
                 af->setBeat(WAIT_SEC * 5);
-                if (af->cgetEventQueueElement())
-                {
-                    g_events.remove(affect_beat, (void *)af, nullptr);
-                }
-                af->setEventQueueElement(g_events.add(number(120, 240), affect_beat, (void *)af, nullptr));
+                affect_join_beat(af, number(120, 240));
                 return;
             }
         }
@@ -257,55 +337,107 @@ unit_affected_type *affected_by_spell(const unit_data *unit, sbit16 id)
 }
 
 /**
- * Called by event handler when its ticking time
+ * Tick a single affect when its beat is due
  */
-void affect_beat(void *p1, void *p2)
+static void affect_tick(unit_affected_type *af)
 {
-    unit_affected_type *af = (unit_affected_type *)p1;
-    int destroyed = 0;
-
     assert(af->getID() >= 0); /* Negative ids (transfer) dont have beats */
 
-    /* Used to be assert(af->beat > 0);  */
-    /* But crashes game, I've set 0 to 8 */
-    if (af->getBeat() <= 0)
-    {
-        af->setBeat(2 * WAIT_SEC);
-    }
-
-    destroyed = FALSE;
-
     if (!af->cgetOwner()->isPC() || CHAR_DESCRIPTOR(af->cgetOwner()))
     {
         if (af->getDuration() == 0)
         {
-            /* 'destroy_affect' will try to destroy the event, but there */
-            /* is none. It doesn't matter though                         */
             destroy_affect(af);
             return;
         }
-        else
+
+        if (af->getTickFI() >= 0)
         {
-            if (af->getTickFI() >= 0)
-            {
-                (*g_tif[af->getTickFI()].func)(af, af->getOwner());
-            }
+            (*g_tif[af->getTickFI()].func)(af, af->getOwner());
+        }
+
+        if (!af->is_destructed() && (af->getDuration() > 0))
+        {
+            af->decrementDuration();
+        }
+    }
+}
 
-            destroyed = af->is_destructed();
+/**
+ * Called by event handler when its ticking time for the affects on
+ * unit p1 with beat p2
+ */
+void affect_beat(void *p1, void *p2)
+{
+    unit_data *unit = (unit_data *)p1;
+    ubit16 beat = (ubit16)(intptr_t)p2;
+    eventq_elem *event = nullptr;
+    unit_affected_type *af = nullptr;
+    unit_affected_type *next = nullptr;
 
-            if (!destroyed && (af->getDuration() > 0))
-            {
-                af->decrementDuration();
-            }
+    /* The event being processed is the one the members point at */
+    for (af = unit->getUnitAffected(); af; af = af->getNext())
+    {
+        if (af->getEventQueueElement() && af->getEventQueueElement()->arg2 == p2)
+        {
+            event = af->getEventQueueElement();
+            break;
+        }
+    }
+
+    /* Tick functions may destroy any affect. Destroyed affects leave their
+       beat when unlinked but keep their next pointer until clear_destruct */
+    for (; af; af = next)
+    {
+        next = af->getNext();
+
+        if (af->is_destructed() || af->getEventQueueElement() != event)
+        {
+            continue;
+        }
+
+        /* Used to be assert(af->beat > 0);  */
+        /* But crashes game, I've set 0 to 8 */
+        if (af->getBeat() <= 0)
+        {
+            af->setBeat(2 * WAIT_SEC);
+        }
+
+        /* The beat was changed since af joined */
+        if (af->getBeat() != beat)
+        {
+            affect_join_beat(af, af->getBeat());
+            continue;
+        }
+
+        if (af->getBeatDue() > g_tics)
+        {
+            continue;
         }
+
+        af->setBeatDue(g_tics + beat);
+        affect_tick(af);
+    }
+
+    if (event == nullptr || event->func == nullptr)
+    {
+        return;
     }
-    if (!destroyed)
+
+    /* Reschedule the beat for the first remaining member due */
+    int due = 0;
+
+    for (af = unit->getUnitAffected(); af; af = af->getNext())
     {
-        if (af->cgetEventQueueElement())
+        if (af->getEventQueueElement() == event && (due == 0 || af->getBeatDue() < due))
         {
-            g_events.remove(affect_beat, (void *)af, nullptr);
+            due = af->getBeatDue();
         }
-        af->setEventQueueElement(g_events.add(af->getBeat(), affect_beat, (void *)af, nullptr));
+    }
+
+    if (due)
+    {
+        affect_move_beat(unit, event, MAX(1, due - g_tics));
     }
 }
 
@@ -339,11 +471,7 @@ void start_affect(unit_data *unit)
     {
         if ((af->getID() >= 0) && (af->getBeat() > 0))
         {
-            if (af->cgetEventQueueElement())
-            {
-                g_events.remove(affect_beat, (void *)af, nullptr);
-            }
-            af->setEventQueueElement(g_events.add(af->getBeat(), affect_beat, (void *)af, nullptr));
+            affect_join_beat(af, af->getBeat());
         }
         else
         {
@@ -358,9 +486,10 @@ void stop_affect(unit_data *unit)
 
     for (af = unit->getUnitAffected(); af; af = af->getNext())
     {
-        if (af->cgetEventQueueElement() != nullptr)
+        if (af->getEventQueueElement() != nullptr)
         {
-            g_events.remove(affect_beat, (void *)af, nullptr);
+            af->getEventQueueElement()->func = nullptr;
+            af->setEventQueueElement(nullptr);
         }
     }
 }
@@ -338,17 +338,30 @@ int CByteBuffer::ReadNames(char ***pppStr, int bOld)
     {
         int l = 0;
         int Corrupt = 0;
-        char buf[MAX_STRING_LENGTH];
 
         l = ReadS32(&Corrupt);
 
+        // Every name takes at least its NUL, so a larger count is corrupt
+        if (Corrupt || l < 0 || (ubit32)l > m_nLength - m_nReadPos)
+        {
+            return 1;
+        }
+
+        // Size the list once and copy the names straight out of the buffer
+        RECREATE(*pppStr, char *, l + 1);
+
         int i = 0;
 
         for (i = 0; i < l; i++)
         {
-            Corrupt += ReadStringCopy(buf, sizeof(buf) - 1);
-            *pppStr = add_name(buf, *pppStr);
+            if (SkipString(&c))
+            {
+                Corrupt = 1;
+                break;
+            }
+            (*pppStr)[i] = str_dup(c);
         }
+        (*pppStr)[i] = nullptr;
 
         return Corrupt;
     }
@@ -76,6 +76,7 @@ cmdload_struct cmdload[] = {{"north", do_move, 0, 0},
                             {"load", do_load, 0, 0},
                             {"timewarp", do_timewarp, 0, 0},
 
+                            {"reloadzone", do_reloadzone, 0, 0},
                             {"rent", do_rent, 0, 0},
                             {"save", do_save, 0, 0},
                             {"set", do_set, 0, 0},
@@ -10,8 +10,89 @@
 #include "json_helper.h"
 #include "textutil.h"
 
+#include <algorithm>
+#include <cassert>
+#include <deque>
 #include <optional>
 #include <sstream>
+#include <unordered_map>
+
+/**
+ * The interned color keywords. A deque keeps the strings in place, so the
+ * index can be keyed by views of them.
+ */
+struct color_keywords
+{
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, ubit16> ids;
+};
+
+static color_keywords &keywords()
+{
+    static color_keywords g_color_keywords;
+    return g_color_keywords;
+}
+
+static ubit16 intern_keyword(std::string keyword)
+{
+    auto &kw = keywords();
+
+    if (auto it = kw.ids.find(keyword); it != kw.ids.end())
+    {
+        return it->second;
+    }
+
+    assert(kw.names.size() < 0xFFFF);
+    auto id = static_cast<ubit16>(kw.names.size());
+    kw.names.push_back(std::move(keyword));
+    kw.ids.emplace(kw.names.back(), id);
+    return id;
+}
+
+static const std::string g_no_color;
+
+const std::string &color_type::keyword(ubit16 id)
+{
+    return keywords().names[id];
+}
+
+/**
+ * The entry for key, or the first entry whose keyword key is a prefix of
+ */
+std::vector<color_type::color_entry>::const_iterator color_type::find(std::string_view key) const
+{
+    auto it = std::lower_bound(m_colors.begin(),
+                               m_colors.end(),
+                               key,
+                               [](const color_entry &e, std::string_view k) { return std::string_view(keyword(e.keyword)) < k; });
+
+    if (it != m_colors.end())
+    {
+        const std::string &kw = keyword(it->keyword);
+        auto min = std::min(key.length(), kw.length());
+        // emulate old strncmp comparison of prefix match
+        if (min > 0 && key.compare(0, min, std::string_view(kw).substr(0, min)) == 0)
+        {
+            return it;
+        }
+    }
+    return m_colors.end();
+}
+
+std::vector<color_type::color_entry>::iterator color_type::find_exact(std::string_view key)
+{
+    auto it = std::lower_bound(m_colors.begin(),
+                               m_colors.end(),
+                               key,
+                               [](const color_entry &e, std::string_view k) { return std::string_view(keyword(e.keyword)) < k; });
+
+    if (it != m_colors.end() && keyword(it->keyword) == key)
+    {
+        return it;
+    }
+    return m_colors.end();
+}
+
 
 std::string color_type::insert(char *key, char *c)
 {
@@ -28,8 +109,18 @@ std::string color_type::insert(std::string keyword, std::string color)
     {
         return {};
     }
-    auto it = m_map.insert_or_assign(std::move(keyword), std::move(color));
-    return {it.first->second + it.first->first};
+    if (auto it = find_exact(keyword); it != m_colors.end())
+    {
+        it->color = std::move(color);
+        return it->color + keyword;
+    }
+
+    auto it = std::lower_bound(m_colors.begin(),
+                               m_colors.end(),
+                               keyword,
+                               [](const color_entry &e, const std::string &k) { return color_type::keyword(e.keyword) < k; });
+    it = m_colors.insert(it, color_entry{intern_keyword(keyword), std::move(color)});
+    return it->color + keyword;
 }
 
 void color_type::change(const char *combo)
@@ -81,71 +172,63 @@ std::string color_type::change(char *key, char *c)
 
 std::string color_type::change(const std::string &keyword, std::string color)
 {
-    if (auto search = m_map.find(keyword); search != m_map.end())
+    if (auto search = find_exact(keyword); search != m_colors.end())
     {
-        search->second = std::move(color);
+        search->color = std::move(color);
 
         std::ostringstream strm;
-        strm << diku::format_to_str("<div class='%s'>%s = %s</div>", search->second, keyword, search->second);
+        strm << diku::format_to_str("<div class='%s'>%s = %s</div>", search->color, keyword, search->color);
         return strm.str();
     }
     return {};
 }
 
-std::string color_type::get(const char *key) const
+const std::string &color_type::get(const char *key) const
 {
     if (!key)
     {
-        return {};
+        return g_no_color;
     }
-    return get(std::string{key});
-}
 
-std::string color_type::get(const std::string &key) const
-{
-    if (auto it = m_map.lower_bound(key); it != m_map.end())
+    if (auto it = find(key); it != m_colors.end())
     {
-        auto min = std::min(key.length(), it->first.length());
-        // emulate old strncmp comparison of prefix match
-        if (min > 0 && key.compare(0, min, it->first, 0, min) == 0)
-        {
-            return it->second;
-        }
+        return it->color;
     }
-    return {};
+    return g_no_color;
+}
+
+const std::string &color_type::get(const std::string &key) const
+{
+    return get(key.c_str());
 }
 
-std::string color_type::get(const char *key, char *full_key) const
+const std::string &color_type::get(const char *key, char *full_key) const
 {
     if (!key)
     {
-        return {};
+        return g_no_color;
     }
 
-    std::string temp_full_key;
-    auto ret = get(std::string{key}, temp_full_key);
-    if (!ret.empty() && full_key)
+    if (auto it = find(key); it != m_colors.end())
     {
-        memcpy(full_key, temp_full_key.data(), temp_full_key.length() + 1);
+        if (full_key)
+        {
+            const std::string &kw = keyword(it->keyword);
+            memcpy(full_key, kw.data(), kw.length() + 1);
+        }
+        return it->color;
     }
-
-    return ret;
+    return g_no_color;
 }
 
-/// @todo write a test that covers the partial key match scenario
-std::string color_type::get(const std::string &key, std::string &full_key) const
+const std::string &color_type::get(const std::string &key, std::string &full_key) const
 {
-    if (auto it = m_map.lower_bound(key); it != m_map.end())
+    if (auto it = find(key); it != m_colors.end())
     {
-        auto min = std::min(key.length(), it->first.length());
-        // emulate old strncmp comparison of prefix match
-        if (min > 0 && key.compare(0, min, it->first, 0, min) == 0)
-        {
-            full_key = it->first;
-            return it->second;
-        }
+        full_key = keyword(it->keyword);
+        return it->color;
     }
-    return {};
+    return g_no_color;
 }
 
 int color_type::remove(char *key)
@@ -159,12 +242,17 @@ int color_type::remove(char *key)
 
 int color_type::remove(const std::string &key)
 {
-    return static_cast<int>(m_map.erase(key));
+    if (auto it = find_exact(key); it != m_colors.end())
+    {
+        m_colors.erase(it);
+        return 1;
+    }
+    return 0;
 }
 
 void color_type::remove_all()
 {
-    m_map.clear();
+    m_colors.clear();
 }
 
 void color_type::create(const char *input_temp)
@@ -211,16 +299,17 @@ void color_type::create(const std::string &input_string)
 
 std::string color_type::key_string()
 {
-    if (m_map.empty())
+    if (m_colors.empty())
     {
         return {};
     }
 
     std::ostringstream strm;
-    for (const auto &[keyword, color] : m_map)
+    for (const auto &[id, color] : m_colors)
     {
-        auto i = std::max(0, 25 - static_cast<int>(keyword.length()));
-        strm << diku::format_to_str("<div class='%s'>%s%s= %s</div><br/>", color, keyword, spc(i), color);
+        const std::string &kw = keyword(id);
+        auto i = std::max(0, 25 - static_cast<int>(kw.length()));
+        strm << diku::format_to_str("<div class='%s'>%s%s= %s</div><br/>", color, kw, spc(i), color);
     }
     strm << "<br/>";
     return strm.str();
@@ -228,28 +317,28 @@ std::string color_type::key_string()
 
 std::string color_type::key_string(const color_type &dft) const
 {
-    auto t = save_string();
-    auto d = dft.save_string(); // ptr to create string
-
-    auto combined_string = d + t;
-
     color_type temp;
-    temp.create(combined_string);
+
+    temp.m_colors = dft.m_colors;
+    for (const auto &[id, color] : m_colors)
+    {
+        (void)temp.insert(keyword(id), color);
+    }
 
     return temp.key_string();
 }
 
 std::string color_type::save_string() const
 {
-    if (m_map.empty())
+    if (m_colors.empty())
     {
         return {};
     }
 
     std::ostringstream strm;
-    for (const auto &[keyword, color] : m_map)
+    for (const auto &[id, color] : m_colors)
     {
-        strm << keyword << ":" << color << ":";
+        strm << keyword(id) << ":" << color << ":";
     }
     return strm.str();
 }
@@ -257,11 +346,11 @@ std::string color_type::save_string() const
 void color_type::toJSON(rapidjson::PrettyWriter<rapidjson::StringBuffer> &writer) const
 {
     writer.StartArray();
-    for (auto &[key, value] : m_map)
+    for (auto &[id, value] : m_colors)
     {
         writer.StartObject();
         {
-            json::write_kvp("keyword", key, writer);
+            json::write_kvp("keyword", keyword(id), writer);
             json::write_kvp("color", value, writer);
         }
         writer.EndObject();
@@ -13,11 +13,33 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
+/**
+ * A table of color keywords and their colors, e.g. "say" -> "cw bn".
+ *
+ * Keywords are interned once for the whole process and a table only stores
+ * the small id, so the default palette and the sparse per-player overrides
+ * share the keyword text. The entries are kept sorted by keyword text and
+ * lookups are a binary search that returns a reference without allocating.
+ * A key that is not in the table matches the first keyword it is a prefix of,
+ * the way the old strncmp() lookup did.
+ */
 class color_type
 {
 private:
-    std::map<std::string, std::string> m_map;
+    struct color_entry
+    {
+        ubit16 keyword; ///< Interned keyword id
+        std::string color;
+    };
+
+    std::vector<color_entry> m_colors; ///< Sorted by keyword text
+
+    [[nodiscard]] static const std::string &keyword(ubit16 id);
+    [[nodiscard]] std::vector<color_entry>::const_iterator find(std::string_view key) const;
+    [[nodiscard]] std::vector<color_entry>::iterator find_exact(std::string_view key);
 
 public:
     // These all use the pointer interface and should be removed later
@@ -29,8 +51,8 @@ public:
     void insert(const char *combo);
     [[nodiscard]] std::string change(char *key, char *c);
     void change(const char *combo);
-    [[nodiscard]] std::string get(const char *key) const;
-    [[nodiscard]] std::string get(const char *key, char *full_key) const;
+    [[nodiscard]] const std::string &get(const char *key) const;
+    [[nodiscard]] const std::string &get(const char *key, char *full_key) const;
     int remove(char *key);
     void create(const char *input_str);
 
@@ -48,8 +70,8 @@ public:
     void insert(const std::string &combo);
     void change(const std::string &combo);
     [[nodiscard]] std::string change(const std::string &keyword, std::string color); // Nothing uses this except the tests
-    [[nodiscard]] std::string get(const std::string &key) const;
-    [[nodiscard]] std::string get(const std::string &key, std::string &full_key) const;
+    [[nodiscard]] const std::string &get(const std::string &key) const;
+    [[nodiscard]] const std::string &get(const std::string &key, std::string &full_key) const;
     int remove(const std::string &key);
     void remove_all();
     void create(const std::string &input_string);
@@ -129,18 +129,19 @@ void substHTMLcolor(std::string &dest, const char *src, color_type &color)
             // We got a color code on our hands, let's see if we need to substitute
             if (l >= 1)
             {
-                auto Col = color.get(buf);
+                // The player's colors only hold the overrides of the default palette
+                const std::string *Col = &color.get(buf);
 
-                if (Col.empty())
+                if (Col->empty())
                 {
-                    Col = g_cServerConfig.getColorType().get(buf);
+                    Col = &g_cServerConfig.getColorType().get(buf);
                 }
 
-                if (Col.empty() == false)
+                if (Col->empty() == false)
                 {
                     // Substitute the color
                     char newtag[256];
-                    substHTMLTagClass(aTag, "class", Col.c_str(), newtag, sizeof(newtag) - 1);
+                    substHTMLTagClass(aTag, "class", Col->c_str(), newtag, sizeof(newtag) - 1);
                     dest.push_back('<');
                     dest.append(newtag);
                     dest.push_back('>');
@@ -284,7 +285,7 @@ void send_to_zone_outdoor(const zone_type *z, const char *messg)
 {
     descriptor_data *i = nullptr;
 
-    if (messg && *messg)
+    if (messg && *messg && z->getNumOfPlayers() > 0)
     {
         for (i = g_descriptor_list; i; i = i->getNext())
         {
@@ -625,6 +626,7 @@ void act(const char *str, actShow_e show_type, cActParameter arg1, cActParameter
 {
     const unit_data *to = nullptr;
     const unit_data *u = nullptr;
+    bool chars = false;
     char buf[MAX_STRING_LENGTH];
 
     if (!str || !*str)
@@ -646,11 +648,13 @@ void act(const char *str, actShow_e show_type, cActParameter arg1, cActParameter
     }
     else
     {
-        to = arg1.m_u->getUnitIn()->getUnitContains();
+        /* Only chars are told, walk past the objects unless one of them holds chars */
+        chars = arg1.m_u->getUnitIn()->charsInCharList();
+        to = chars ? arg1.m_u->getUnitIn()->getCharContains() : arg1.m_u->getUnitIn()->getUnitContains();
     }
 
     /* same unit or to person */
-    for (; to; to = to->getNext())
+    for (; to; to = chars ? to->getNextChar() : to->getNext())
     {
         if (to->isChar() && CHAR_DESCRIPTOR(to))
         {
@@ -664,7 +668,7 @@ void act(const char *str, actShow_e show_type, cActParameter arg1, cActParameter
         }
         if (to->getNumberOfCharactersInsideUnit() && to->isTransparent())
         {
-            for (u = to->getUnitContains(); u; u = u->getNext())
+            for (u = to->getCharContains(); u; u = u->getNextChar())
             {
                 if (u->isChar() && CHAR_DESCRIPTOR(u))
                 {
@@ -678,7 +682,8 @@ void act(const char *str, actShow_e show_type, cActParameter arg1, cActParameter
     /* other units outside transparent unit */
     if (arg1.m_u->getUnitIn() && (to = arg1.m_u->getUnitIn()->getUnitIn()) && arg1.m_u->getUnitIn()->isTransparent())
     {
-        for (to = to->getUnitContains(); to; to = to->getNext())
+        chars = to->charsInCharList(arg1.m_u->getUnitIn());
+        for (to = chars ? to->getCharContains() : to->getUnitContains(); to; to = chars ? to->getNextChar() : to->getNext())
         {
             if (to->isChar() && CHAR_DESCRIPTOR(to))
             {
@@ -688,7 +693,7 @@ void act(const char *str, actShow_e show_type, cActParameter arg1, cActParameter
 
             if (to->getNumberOfCharactersInsideUnit() && to->isTransparent() && to != arg1.m_u->getUnitIn())
             {
-                for (u = to->getUnitContains(); u; u = u->getNext())
+                for (u = to->getCharContains(); u; u = u->getNextChar())
                 {
                     if (u->isChar() && CHAR_DESCRIPTOR(u))
                     {
@@ -705,6 +710,7 @@ void cact(const char *str, actShow_e show_type, cActParameter arg1, cActParamete
 {
     const unit_data *to = nullptr;
     const unit_data *u = nullptr;
+    bool chars = false;
     char buf[MAX_STRING_LENGTH];
     char temp[MAX_STRING_LENGTH];
     char *t = nullptr;
@@ -729,11 +735,13 @@ void cact(const char *str, actShow_e show_type, cActParameter arg1, cActParamete
     }
     else
     {
-        to = arg1.m_u->getUnitIn()->getUnitContains();
+        /* Only chars are told, walk past the objects unless one of them holds chars */
+        chars = arg1.m_u->getUnitIn()->charsInCharList();
+        to = chars ? arg1.m_u->getUnitIn()->getCharContains() : arg1.m_u->getUnitIn()->getUnitContains();
     }
 
     /* same unit or to person */
-    for (; to; to = to->getNext())
+    for (; to; to = chars ? to->getNextChar() : to->getNext())
     {
         if (to->isChar() && CHAR_DESCRIPTOR(to))
         {
@@ -760,7 +768,7 @@ void cact(const char *str, actShow_e show_type, cActParameter arg1, cActParamete
 
         if (to->getNumberOfCharactersInsideUnit() && to->isTransparent())
         {
-            for (u = to->getUnitContains(); u; u = u->getNext())
+            for (u = to->getCharContains(); u; u = u->getNextChar())
             {
                 if (u->isChar() && CHAR_DESCRIPTOR(u))
                 {
@@ -781,7 +789,8 @@ void cact(const char *str, actShow_e show_type, cActParameter arg1, cActParamete
     /* other units outside transparent unit */
     if ((to = arg1.m_u->getUnitIn()->getUnitIn()) && arg1.m_u->getUnitIn()->isTransparent())
     {
-        for (to = to->getUnitContains(); to; to = to->getNext())
+        chars = to->charsInCharList(arg1.m_u->getUnitIn());
+        for (to = chars ? to->getCharContains() : to->getUnitContains(); to; to = chars ? to->getNextChar() : to->getNext())
         {
             if (to->isChar() && CHAR_DESCRIPTOR(to))
             {
@@ -797,7 +806,7 @@ void cact(const char *str, actShow_e show_type, cActParameter arg1, cActParamete
 
             if (to->getNumberOfCharactersInsideUnit() && to->isTransparent() && to != arg1.m_u->getUnitIn())
             {
-                for (u = to->getUnitContains(); u; u = u->getNext())
+                for (u = to->getCharContains(); u; u = u->getNextChar())
                 {
                     if (u->isChar() && CHAR_DESCRIPTOR(u))
                     {
@@ -10,6 +10,7 @@
 #include "act_other.h"
 #include "affect.h"
 #include "ban.h"
+#include "cmdload.h"
 #include "common.h"
 #include "convert.h"
 #include "db_file.h"
@@ -18,6 +19,7 @@
 #include "dilrun.h"
 #include "error.h"
 #include "files.h"
+#include "formatter.h"
 #include "handler.h"
 #include "interpreter.h"
 #include "main_functions.h"
@@ -45,6 +47,8 @@
 #include <cstring>
 #include <filesystem>
 #include <memory>
+#include <set>
+#include <vector>
 
 const char *g_player_zone = "_players";
 
@@ -177,83 +181,122 @@ void resolve_templates()
 }
 
 /**
- * Generate and read DIL templates
+ * The contents of the '.data' file of a zone. The file is read in full
+ * before any of it is put into the zone, so a reload can refuse a file
+ * without leaving the zone half updated.
  */
-diltemplate *generate_datafile_diltemplates(FILE *f, zone_type *zone, bool do_reindex)
+struct zone_datafile
+{
+    int weather_base{0};
+    std::string notes;
+    std::string help;
+    std::vector<std::string> creators;
+    std::string title;
+    ubit32 crc{0}; ///< Every template and unit carries the CRC of the file
+    int rooms{0};
+    std::vector<std::unique_ptr<diltemplate>> templates;
+    std::vector<std::unique_ptr<file_index_type>> indexes;
+};
+
+/**
+ * Note the file CRC 'crc' of a template or unit, which must be the same
+ * throughout the file.
+ */
+static bool datafile_crc(zone_datafile *data, ubit32 crc, std::string *failed)
+{
+    if (data->crc != 0 && data->crc != crc)
+    {
+        *failed = "The file CRC changes within the file.";
+        return false;
+    }
+
+    data->crc = crc;
+    return true;
+}
+
+/**
+ * Read the DIL templates of the '.data' file 'f' of 'zone' into 'data'.
+ * Returns false with the reason in 'failed' if the file is corrupt.
+ */
+static bool generate_datafile_diltemplates(FILE *f, zone_type *zone, zone_datafile *data, std::string *failed)
 {
-    diltemplate *tmpllist = nullptr;
     CByteBuffer Buf;
     sbit32 tmplsize = 0;
     char nBuf[256];
     char zBuf[256];
 
-    tmpllist = nullptr;
-
     /*
      * The global templates are preceded with their length
      * written by write_template() in db_file.c and now also
      * the filecrc
      */
 
-    ubit32 filecrc = 0;
-    while (!feof(f))
+    for (;;)
     {
         if (fread(&(tmplsize), sizeof(ubit32), 1, f) != 1)
         {
-            error(HERE, "Failed to fread() tmplsize");
+            *failed = "Failed to fread() tmplsize.";
+            return false;
         }
 
         if (tmplsize == 0) // End of templates marker
         {
-            break;
+            return true;
         }
 
         if (tmplsize < 0)
         {
-            error(HERE, "Unexpected templatesize");
+            *failed = "Unexpected templatesize.";
+            return false;
         }
 
+        ubit32 filecrc = 0;
         if (fread(&(filecrc), sizeof(filecrc), 1, f) != 1)
         {
-            error(HERE, "Failed to fread() filecrc");
+            *failed = "Failed to fread() filecrc.";
+            return false;
         }
-        zone->setCrc(filecrc);
 
-        Buf.FileRead(f, tmplsize);
+        if (!datafile_crc(data, filecrc, failed))
+        {
+            return false;
+        }
 
-        auto tmpl = std::unique_ptr<diltemplate>(bread_diltemplate(&Buf, UNIT_VERSION));
+        if (Buf.FileRead(f, tmplsize) != tmplsize)
+        {
+            *failed = "A DIL template is cut short.";
+            return false;
+        }
 
-        if (tmpl)
+        auto tmpl = std::unique_ptr<diltemplate>(bread_diltemplate(&Buf, UNIT_VERSION));
+        if (!tmpl)
         {
-            tmpl->zone = zone;
+            *failed = "Couldn't read DIL template.";
+            return false;
+        }
 
-            split_fi_ref(tmpl->prgname, zBuf, nBuf);
+        bread_dillines(&Buf, tmpl.get());
+        tmpl->zone = zone;
 
-            FREE(tmpl->prgname);
+        split_fi_ref(tmpl->prgname, zBuf, nBuf);
 
-            tmpl->prgname = str_dup(nBuf);
-            str_lower(tmpl->prgname);
-            zone->insertDILTemplate(std::move(tmpl));
-        }
-        else
-        {
-            error(HERE, "Couldn't read DIL template.");
-        }
-    }
+        FREE(tmpl->prgname);
 
-    return tmpllist;
+        tmpl->prgname = str_dup(nBuf);
+        str_lower(tmpl->prgname);
+        data->templates.push_back(std::move(tmpl));
+    }
 }
 
 /**
- * Generate index's for each unit in the '.data' file 'f', zone 'zone'
+ * Generate index's for each unit in the '.data' file 'f', zone 'zone', into 'data'.
  * Format is: string(name), ubit32(filecrc), ubit8(unit type), ubit32(unit string data length), ubit32(datacrc)
- * Returns number of rooms read.
+ * Returns false with the reason in 'failed' if the file is corrupt.
  */
-int generate_datafile_file_indexes(FILE *f, zone_type *zone, bool do_reindex)
+static bool generate_datafile_file_indexes(FILE *f, zone_type *zone, zone_datafile *data, std::string *failed)
 {
     CByteBuffer cBuf(100);
-
-    int room_number = 0;
+    long size = fsize(f);
 
     for (;;)
     {
@@ -261,32 +304,41 @@ int generate_datafile_file_indexes(FILE *f, zone_type *zone, bool do_reindex)
 
         if (feof(f))
         {
-            break;
+            if (cBuf.GetLength() > 1)
+            {
+                *failed = "The unit names are cut short.";
+                return false;
+            }
+            return true;
         }
 
+        const char *name = (const char *)cBuf.GetData();
+
         ubit8 temp_8{};  // get Type
         if (fread(&temp_8, sizeof(ubit8), 1, f) != 1)
         {
-            error(HERE, "Failed to fread() unit type");
+            *failed = diku::format_to_str("Failed to fread() unit type of %s.", name);
+            return false;
         }
 
         // Maybe the file_index constructor should require a name and a zone.
-        auto temp_index = std::make_unique<file_index_type>(zone, (const char *) cBuf.GetData(), temp_8);
+        auto temp_index = std::make_unique<file_index_type>(zone, name, temp_8);
 
         // get Length
         sbit32 temp_32{};
-        if (fread(&temp_32, sizeof(ubit32), 1, f) != 1)
+        if (fread(&temp_32, sizeof(ubit32), 1, f) != 1 || temp_32 <= 0)
         {
-            error(HERE, "Failed to fread() temp_index->length");
+            *failed = diku::format_to_str("Failed to fread() length of %s.", name);
+            return false;
         }
-        assert(temp_32 > 0);
         temp_index->setLength(temp_32);
 
         // get data CRC
         temp_32 = 0;
         if (fread(&temp_32, sizeof(ubit32), 1, f) != 1)
         {
-            error(HERE, "Failed to fread() temp_index->crc");
+            *failed = diku::format_to_str("Failed to fread() crc of %s.", name);
+            return false;
         }
         temp_index->setCRC(temp_32);
 
@@ -297,73 +349,63 @@ int generate_datafile_file_indexes(FILE *f, zone_type *zone, bool do_reindex)
         // get fileCRC (zone based)
         if (fread(&temp_32, sizeof(ubit32), 1, f) != 1)
         {
-            error(HERE, "Failed to fread() filecrc for the zone");
+            *failed = diku::format_to_str("Failed to fread() filecrc of %s.", name);
+            return false;
+        }
+
+        if (!datafile_crc(data, temp_32, failed))
+        {
+            return false;
         }
-        zone->setCrc(temp_32); // Will fail if CRC changes
 
         temp_index->setFilepos(startReadPos);
 
         if (temp_index->getType() == UNIT_ST_ROOM)
         {
-            temp_index->setRoomNum(room_number++);
+            temp_index->setRoomNum(data->rooms++);
         }
 
         // Skip over the 'data' portion since we didnn't read it from the file
         // i.e. skip forward "length" from the current file position
+        if (ftell(f) + temp_index->getLength() > size)
+        {
+            *failed = diku::format_to_str("The data of %s is cut short.", name);
+            return false;
+        }
         fseek(f, ftell(f) + temp_index->getLength(), SEEK_SET);
 
-        zone->insertFileIndex(std::move(temp_index));
+        data->indexes.push_back(std::move(temp_index));
     }
-
-    return room_number;
 }
 
-
-// Parses zone.data binary file on disk. 
-// Returns true if successful, false otherwise
-//
-bool parse_datafile(zone_type *zone, bool do_reindex)
+/**
+ * Read the '.data' file 'f' of 'zone' into 'data'. Returns false with the
+ * reason in 'failed' if the file is not for the zone or is corrupt.
+ */
+static bool read_datafile(FILE *f, zone_type *zone, zone_datafile *data, std::string *failed)
 {
-    FILE *f = nullptr;
     CByteBuffer cBuf(MAX_STRING_LENGTH);
-    char filename[82 + 41];
-
-    snprintf(filename, sizeof(filename), "%s%s.data", g_cServerConfig.getZoneDir().c_str(), zone->getName().c_str());
-
-    if ((f = fopen_cache(filename, "rb")) == nullptr)
-    {
-        slog(LOG_OFF, 0, "Could not open data file: %s", filename);
-        return false; /* Next file, please */
-    }
-
-    if (fsize(f) <= 3)
-    {
-        slog(LOG_OFF, 0, "Data file empty: %s", filename);
-        return false; /* Next file, please */
-    }
 
     fstrcpy(&cBuf, f);
 
     if (str_ccmp((char *)cBuf.GetData(), zone->getName().c_str()) != 0)
     {
-        error(HERE, "ERROR: Zone name %s must match the filename on disk: %s ", (char *)cBuf.GetData(), zone->getName());
+        *failed = diku::format_to_str("Zone name %s must match the filename on disk: %s", (char *)cBuf.GetData(), zone->getName());
+        return false;
     }
 
-    int temp1{0};
-    int mstmp = fread(&temp1, sizeof(int), 1, f);
-    if (mstmp < 1)
+    if (fread(&data->weather_base, sizeof(int), 1, f) != 1)
     {
-        slog(LOG_ALL, 0, "ERROR: Unexpected end of stream %d in db.cpp", mstmp);
-        assert(FALSE);
+        *failed = "Unexpected end of stream.";
+        return false;
     }
-    zone->getWeather().setBase(temp1);
 
     /* More data read here */
     fstrcpy(&cBuf, f);
-    zone->setNotes(str_dup((char *)cBuf.GetData()));
+    data->notes = (char *)cBuf.GetData();
 
     fstrcpy(&cBuf, f);
-    zone->setHelp(str_dup((char *)cBuf.GetData()));
+    data->help = (char *)cBuf.GetData();
 
     for (;;)
     {
@@ -374,27 +416,100 @@ bool parse_datafile(zone_type *zone, bool do_reindex)
             break;
         }
 
-        zone->getCreators().AppendName((char *)cBuf.GetData());
+        data->creators.emplace_back((char *)cBuf.GetData());
     }
 
     fstrcpy(&cBuf, f);
+    data->title = (char *)cBuf.GetData();
 
-    if (cBuf.GetData()[0] != 0)
+    if (feof(f))
     {
-        zone->setTitle(str_dup((char *)cBuf.GetData()));
+        *failed = "Unexpected end of stream.";
+        return false;
     }
-    else
+
+    return generate_datafile_diltemplates(f, zone, data, failed) && generate_datafile_file_indexes(f, zone, data, failed);
+}
+
+// Parses zone.data binary file on disk. 
+// Returns true if successful, false otherwise. A reload (do_reindex) is
+// refused with the reason in 'refused' if the new file can not be read or
+// merged, and the zone is then left as it was.
+//
+bool parse_datafile(zone_type *zone, bool do_reindex, std::string *refused)
+{
+    FILE *f = nullptr;
+    char filename[82 + 41];
+
+    snprintf(filename, sizeof(filename), "%s%s.data", g_cServerConfig.getZoneDir().c_str(), zone->getName().c_str());
+
+    if ((f = fopen_cache(filename, "rb")) == nullptr)
     {
-        zone->setTitle(str_dup(""));
+        slog(LOG_OFF, 0, "Could not open data file: %s", filename);
+        return false; /* Next file, please */
     }
 
-    generate_datafile_diltemplates(f, zone, do_reindex);  // Read DIL templates
-    int room_count = generate_datafile_file_indexes(f, zone, do_reindex);
+    if (fsize(f) <= 3)
+    {
+        slog(LOG_OFF, 0, "Data file empty: %s", filename);
+        return false; /* Next file, please */
+    }
 
-    zone->setNumOfRooms(room_count); /* Number of rooms in the zone */
+    zone_datafile data;
+    std::string failed;
+    bool ok = read_datafile(f, zone, &data, &failed);
 
     fflush(f); /* Don't fclose(f); since we are using fopen_cache */
 
+    if (ok && do_reindex)
+    {
+        failed = zone->checkFileIndexes(data.indexes);
+        ok = failed.empty();
+    }
+
+    if (!ok)
+    {
+        if (!do_reindex)
+        {
+            error(HERE, "ERROR: Data file %s: %s", filename, failed);
+        }
+        if (refused)
+        {
+            *refused = failed;
+        }
+        return false;
+    }
+
+    zone->getWeather().setBase(data.weather_base);
+    zone->setNotes(data.notes);
+    zone->setHelp(data.help);
+    zone->getCreators().Free();
+    for (const auto &creator : data.creators)
+    {
+        zone->getCreators().AppendName(creator.c_str());
+    }
+    zone->setTitle(data.title);
+    zone->clearCrc();
+    zone->setCrc(data.crc);
+
+    if (do_reindex)
+    {
+        /* Rooms are not added by a reload */
+        zone->reindexDILTemplates(std::move(data.templates));
+        zone->reindexFileIndexes(std::move(data.indexes));
+        return true;
+    }
+
+    for (auto &tmpl : data.templates)
+    {
+        zone->insertDILTemplate(std::move(tmpl));
+    }
+    for (auto &index : data.indexes)
+    {
+        zone->insertFileIndex(std::move(index));
+    }
+    zone->setNumOfRooms(data.rooms); /* Number of rooms in the zone */
+
     return true;
 }
 
@@ -517,7 +632,7 @@ void generate_zone_indexes()
         }
         z->setZoneResetCommands(nullptr);
 
-        if (parse_datafile(z, false))
+        if (parse_datafile(z, false, nullptr))
         {
             // Insert zone into sorted list
             g_zone_info.mmp.insert(std::make_pair(z->getName(), z));
@@ -1401,7 +1516,8 @@ unit_data *read_unit(file_index_type *org_fi, int ins_list)
         return nullptr;
     }
 
-    if (is_slimed(org_fi))
+    /* A zero length is a unit removed from its zone by reload_zone() */
+    if (is_slimed(org_fi) || org_fi->getLength() == 0)
     {
         org_fi = g_slime_fi;
     }
@@ -1526,131 +1642,105 @@ void normalize_world()
 /** For local error purposes */
 static zone_type *read_zone_error = nullptr;
 
-zone_reset_cmd *read_zone_reset(FILE *f, zone_reset_cmd *cmd_list)
+/**
+ * Read the zone and unit name of reference 'i' of 'cmd'. Returns false when
+ * the file ends or the names are too long to be names.
+ */
+static bool read_zone_reset_ref(FILE *f, zone_reset_cmd *cmd, int i)
 {
-    zone_reset_cmd *cmd = nullptr;
-    zone_reset_cmd *tmp_cmd = nullptr;
     file_index_type *fi = nullptr;
-    ubit8 cmdno = 0;
-    ubit8 direction = 0;
     char zonename[FI_MAX_ZONENAME + 1];
     char name[FI_MAX_UNITNAME + 1];
     CByteBuffer cBuf(100);
 
-    tmp_cmd = cmd_list;
+    fstrcpy(&cBuf, f);
 
-    while (((cmdno = (ubit8)fgetc(f)) != 255) && !feof(f))
+    if (feof(f) || strlen((char *)cBuf.GetData()) > FI_MAX_ZONENAME)
     {
-        cmd = new zone_reset_cmd();
-        cmd->setCommandNum(cmdno);
-
-        fstrcpy(&cBuf, f);
-
-        if (feof(f))
-        {
-            break;
-        }
+        return false;
+    }
 
-        strcpy(zonename, (char *)cBuf.GetData());
+    strcpy(zonename, (char *)cBuf.GetData());
 
-        fstrcpy(&cBuf, f);
+    fstrcpy(&cBuf, f);
 
-        if (feof(f))
-        {
-            break;
-        }
+    if (feof(f) || strlen((char *)cBuf.GetData()) > FI_MAX_UNITNAME)
+    {
+        return false;
+    }
 
-        strcpy(name, (char *)cBuf.GetData());
+    strcpy(name, (char *)cBuf.GetData());
 
-        if (*zonename && *name)
+    if (*zonename && *name)
+    {
+        if ((fi = find_file_index(zonename, name)))
         {
-            if ((fi = find_file_index(zonename, name)))
-            {
-                cmd->setFileIndexType(0, fi);
-            }
-            else
-            {
-                szonelog(read_zone_error, "Slimed: Illegal ref.: %s@%s", name, zonename);
-                cmd->setFileIndexType(0, g_slime_fi);
-            }
+            cmd->setFileIndexType(i, fi);
         }
         else
         {
-            cmd->setFileIndexType(0, nullptr);
+            szonelog(read_zone_error, "Slimed: Illegal ref.: %s@%s", name, zonename);
+            cmd->setFileIndexType(i, g_slime_fi);
         }
+    }
+    else
+    {
+        cmd->setFileIndexType(i, nullptr);
+    }
 
-        fstrcpy(&cBuf, f);
-
-        if (feof(f))
-        {
-            break;
-        }
-
-        strcpy(zonename, (char *)cBuf.GetData());
-
-        fstrcpy(&cBuf, f);
+    return true;
+}
 
-        if (feof(f))
-        {
-            break;
-        }
+/**
+ * Read the reset commands of a .reset file up to the end of the file or of
+ * the nesting level. '*ok' is cleared when the file is cut short or corrupt,
+ * the commands read so far are returned anyway.
+ */
+static zone_reset_cmd *read_zone_reset(FILE *f, bool *ok)
+{
+    zone_reset_cmd *cmd_list = nullptr;
+    zone_reset_cmd *cmd = nullptr;
+    zone_reset_cmd *tmp_cmd = nullptr;
+    ubit8 cmdno = 0;
+    ubit8 direction = 0;
 
-        strcpy(name, (char *)cBuf.GetData());
+    while (((cmdno = (ubit8)fgetc(f)) != 255) && !feof(f))
+    {
+        cmd = new zone_reset_cmd();
+        cmd->setCommandNum(cmdno);
 
-        if (*zonename && *name)
+        /* Link into list of next command */
+        if (cmd_list == nullptr)
         {
-            if ((fi = find_file_index(zonename, name)))
-            {
-                cmd->setFileIndexType(1, fi);
-            }
-            else
-            {
-                szonelog(read_zone_error, "Illegal ref.: %s@%s", name, zonename);
-                cmd->setFileIndexType(1, g_slime_fi);
-            }
+            cmd_list = cmd;
+            tmp_cmd = cmd;
         }
         else
         {
-            cmd->setFileIndexType(1, nullptr);
-        }
-
-        sbit16 temp{};
-        if (fread(&temp, sizeof(temp), 1, f) != 1)
-        {
-            error(HERE, "Failed to fread() cmd->num[0]");
-        }
-        cmd->setNum(0, temp);
-
-        if (fread(&temp, sizeof(temp), 1, f) != 1)
-        {
-            error(HERE, "Failed to fread() cmd->num[1]");
+            tmp_cmd->setNextPtr(cmd);
+            tmp_cmd = cmd;
         }
-        cmd->setNum(1, temp);
 
-        if (fread(&temp, sizeof(temp), 1, f) != 1)
+        if (!read_zone_reset_ref(f, cmd, 0) || !read_zone_reset_ref(f, cmd, 1))
         {
-            error(HERE, "Failed to fread() cmd->num[2]");
+            szonelog(read_zone_error, "Reset file ends inside a command.");
+            *ok = false;
+            return cmd_list;
         }
-        cmd->setNum(2, temp);
 
+        sbit16 temp[3]{};
         ubit8 temp2{};
-        if (fread(&temp2, sizeof(temp2), 1, f) != 1)
-        {
-            error(HERE, "Failed to fread() cmd->cmpl");
-        }
-        cmd->setCompleteFlag(temp2);
-
-        /* Link into list of next command */
-        if (cmd_list == nullptr)
+        if (fread(temp, sizeof(temp), 1, f) != 1 || fread(&temp2, sizeof(temp2), 1, f) != 1)
         {
-            cmd_list = cmd;
-            tmp_cmd = cmd;
+            szonelog(read_zone_error, "Reset file ends inside a command.");
+            *ok = false;
+            return cmd_list;
         }
-        else
+        for (int i = 0; i < 3; i++)
         {
-            tmp_cmd->setNextPtr(cmd);
-            tmp_cmd = cmd;
+            cmd->setNum(i, temp[i]);
         }
+        cmd->setCompleteFlag(temp2);
 
         direction = (ubit8)fgetc(f);
 
@@ -1660,7 +1750,11 @@ zone_reset_cmd *read_zone_reset(FILE *f, zone_reset_cmd *cmd_list)
                 break;
 
             case ZON_DIR_NEST:
-                cmd->setNestedPtr(read_zone_reset(f, nullptr));
+                cmd->setNestedPtr(read_zone_reset(f, ok));
+                if (!*ok)
+                {
+                    return cmd_list;
+                }
                 break;
 
             case ZON_DIR_UNNEST:
@@ -1669,13 +1763,58 @@ zone_reset_cmd *read_zone_reset(FILE *f, zone_reset_cmd *cmd_list)
 
             default:
                 szonelog(read_zone_error, "Serious Error: Unknown zone direction: %d", direction);
-                break;
+                *ok = false;
+                return cmd_list;
         }
     }
 
     return cmd_list;
 }
 
+/**
+ * Read the .reset file of a zone. The zone is only changed when the whole
+ * file could be read, otherwise false is returned and the reason is logged.
+ */
+static bool read_zone_reset_file(zone_type *zone)
+{
+    read_zone_error = zone;
+
+    std::filesystem::path filename{g_cServerConfig.getZoneDir()};
+    filename += zone->getName();
+    filename += ".reset";
+    FILE *f = fopen(filename.c_str(), "rb");
+    if (f == nullptr)
+    {
+        slog(LOG_OFF, 0, "Could not open zone file: %s", zone->getName());
+        return false;
+    }
+
+    ubit16 zone_time{0};
+    ubit8 reset_mode{0};
+    if (fread(&zone_time, sizeof(zone_time), 1, f) != 1 || fread(&reset_mode, sizeof(reset_mode), 1, f) != 1)
+    {
+        slog(LOG_OFF, 0, "Reset file of zone %s is too short.", zone->getName());
+        fclose(f);
+        return false;
+    }
+
+    bool ok = true;
+    zone_reset_cmd *cmds = read_zone_reset(f, &ok);
+    fclose(f);
+
+    if (!ok)
+    {
+        slog(LOG_OFF, 0, "Reset file of zone %s is corrupt, see the zone log.", zone->getName());
+        free_zone_reset(cmds);
+        return false;
+    }
+
+    zone->setZoneResetTime(zone_time);
+    zone->setResetMode(reset_mode);
+    zone->setZoneResetCommands(cmds);
+
+    return true;
+}
 
 // Reads .reset file from a zone
 //
@@ -1683,43 +1822,242 @@ void read_all_zones_reset()
 {
     for (auto zone = g_zone_info.mmp.begin(); zone != g_zone_info.mmp.end(); zone++)
     {
-        read_zone_error = zone->second;
-
         if (zone->second->getName() == "_players")
         {
             continue;
         }
 
-        std::filesystem::path filename{g_cServerConfig.getZoneDir()};
-        filename += zone->second->getName();
-        filename += ".reset";
-        FILE *f = fopen(filename.c_str(), "rb");
-        if (f == nullptr)
+        if (!read_zone_reset_file(zone->second))
         {
-            slog(LOG_OFF, 0, "Could not open zone file: %s", zone->second->getName());
             exit(10);
         }
+    }
+}
+
+/**
+ * Returns the template in 'zone' replacing 'tmpl' if tmpl is a template of
+ * 'zone' that was retired by a reload and the new template has the same
+ * signature. Otherwise tmpl itself is returned.
+ */
+static diltemplate *rebind_template(diltemplate *tmpl, zone_type *zone)
+{
+    if (tmpl == nullptr || tmpl->zone != zone || zone->findDILTemplate(tmpl->prgname) == tmpl)
+    {
+        return tmpl;
+    }
 
-        ubit16 temp{0};
-        if (fread(&temp, sizeof(ubit16), 1, f) != 1)
+    diltemplate *ntmpl = zone->findDILTemplate(tmpl->prgname);
+
+    if (ntmpl == nullptr || ntmpl->rtnt != tmpl->rtnt || ntmpl->argc != tmpl->argc ||
+        (tmpl->argc > 0 && memcmp(ntmpl->argt, tmpl->argt, sizeof(*tmpl->argt) * tmpl->argc) != 0))
+    {
+        szonelog(zone, "Reload: %s is gone or changed signature, the old version stays in use.", tmpl->prgname);
+        return tmpl;
+    }
+
+    return ntmpl;
+}
+
+/**
+ * Point everything resolved at boot time to templates of 'zone' at the
+ * reloaded templates: the external references of all templates, the
+ * command table, the spell table and the required global DIL programs.
+ * Running programs keep the template they were started from.
+ */
+static void rebind_templates(zone_type *zone)
+{
+    zone->resolveZoneTemplates();
+
+    for (auto &z : g_zone_info.mmp)
+    {
+        if (z.second != zone)
         {
-            error(HERE, "Failed to fread() zone->second->zone_time");
+            z.second->rebindZoneTemplates(zone);
         }
-        zone->second->setZoneResetTime(temp);
+    }
+
+    for (command_info *cmd = g_cmdlist; cmd; cmd = cmd->next)
+    {
+        cmd->tmpl = rebind_template(cmd->tmpl, zone);
+    }
+
+    for (auto &spell : g_spell_info)
+    {
+        spell.tmpl = rebind_template(spell.tmpl, zone);
+    }
+
+    for (diltemplate **global : {&g_dil_change,
+                                 &g_dil_death,
+                                 &g_dil_regen,
+                                 &g_dil_follow,
+                                 &g_dil_set_witness,
+                                 &g_dil_worms,
+                                 &g_dil_on_connect,
+                                 &g_dil_dispatcher,
+                                 &g_dil_playerinit,
+                                 &g_dil_nanny_dil,
+                                 &g_dil_link_dead,
+                                 &g_dil_advance_level,
+                                 &g_dil_initial_prg})
+    {
+        *global = rebind_template(*global, zone);
+    }
+}
+
+/**
+ * Free the templates retired by zone reloads that nothing refers to any more:
+ * no running program has a frame in them, and no command, spell, global
+ * program or template still in use calls them.
+ */
+static void free_retired_templates()
+{
+    std::set<const diltemplate *> in_use;
+    std::vector<const diltemplate *> todo;
 
-        ubit8 temp2{0};
-        if (fread(&temp2, sizeof(ubit8), 1, f) != 1)
+    auto use = [&in_use, &todo](const diltemplate *tmpl) {
+        if (tmpl && in_use.insert(tmpl).second)
         {
-            error(HERE, "Failed to fread() zone->second->reset_mode");
+            todo.push_back(tmpl);
         }
-        zone->second->setResetMode(temp2);
+    };
 
-        zone->second->setZoneResetCommands(read_zone_reset(f, nullptr));
+    for (auto &z : g_zone_info.mmp)
+    {
+        zone_type *zone = z.second;
 
-        fclose(f);
+        zone->forEachDILTemplate([&](diltemplate *tmpl) {
+            if (zone->findDILTemplate(tmpl->prgname) == tmpl)
+            {
+                use(tmpl);
+            }
+
+            /* Every program is listed in the template of its first frame */
+            for (dilprg *prg = tmpl->prg_list; prg; prg = prg->next)
+            {
+                for (dilframe *frm = prg->frame; prg->fp && frm <= prg->fp; frm++)
+                {
+                    use(frm->tmpl);
+                }
+            }
+        });
+    }
+
+    for (command_info *cmd = g_cmdlist; cmd; cmd = cmd->next)
+    {
+        use(cmd->tmpl);
+    }
+
+    for (auto &spell : g_spell_info)
+    {
+        use(spell.tmpl);
+    }
+
+    for (diltemplate *global : {g_dil_change,
+                                g_dil_death,
+                                g_dil_regen,
+                                g_dil_follow,
+                                g_dil_set_witness,
+                                g_dil_worms,
+                                g_dil_on_connect,
+                                g_dil_dispatcher,
+                                g_dil_playerinit,
+                                g_dil_nanny_dil,
+                                g_dil_link_dead,
+                                g_dil_advance_level,
+                                g_dil_initial_prg})
+    {
+        use(global);
+    }
+
+    while (!todo.empty())
+    {
+        const diltemplate *tmpl = todo.back();
+        todo.pop_back();
+
+        for (int i = 0; tmpl->extprg && i < tmpl->xrefcount; i++)
+        {
+            use(tmpl->extprg[i]);
+        }
+    }
+
+    size_t freed = 0;
+    for (auto &z : g_zone_info.mmp)
+    {
+        freed += z.second->freeRetiredDILTemplates(in_use);
+    }
+
+    if (freed)
+    {
+        slog(LOG_ALL, 0, "Freed %d retired DIL templates.", (int)freed);
     }
 }
 
+/**
+ * Reload the compiled .data and .reset files of a zone without a reboot.
+ *
+ * Only the tables of the zone are touched. File indexes are updated in place
+ * so units, reset commands of other zones and symbolic references keep their
+ * pointers, and units loaded from now on are read from the new data. Units
+ * already in the game are left as they are. DIL templates are replaced and the
+ * old ones kept for the programs running them until nothing uses them. Rooms
+ * are part of the world graph, new rooms and changes to the existing ones need
+ * a reboot, and so does a unit changing its type. The reload is refused before
+ * any unit or template is merged in that case. The old reset commands are kept
+ * if the new .reset file can not be read.
+ *
+ * Returns an empty string on success, otherwise the reason for failing.
+ */
+std::string reload_zone(zone_type *zone)
+{
+    CByteBuffer cBuf(MAX_STRING_LENGTH);
+
+    if (zone->getName() == "_players")
+    {
+        return "The players zone can not be reloaded.";
+    }
+
+    std::string datafile = g_cServerConfig.getZoneDir() + zone->getName() + ".data";
+    std::string resetfile = g_cServerConfig.getZoneDir() + zone->getName() + ".reset";
+
+    if (!file_exists(resetfile))
+    {
+        return diku::format_to_str("No reset file %s.", resetfile);
+    }
+
+    /* The data file may have been replaced since it was cached */
+    fclose_cache(datafile.c_str());
+
+    FILE *f = fopen_cache(datafile, "rb");
+    if (f == nullptr || fsize(f) <= 3)
+    {
+        return diku::format_to_str("No data file %s.", datafile);
+    }
+
+    fstrcpy(&cBuf, f);
+    if (str_ccmp((char *)cBuf.GetData(), zone->getName().c_str()) != 0)
+    {
+        return diku::format_to_str("The data file %s is for zone %s.", datafile, (char *)cBuf.GetData());
+    }
+
+    slog(LOG_ALL, 0, "Reloading zone %s.", zone->getName());
+
+    std::string refused;
+    if (!parse_datafile(zone, true, &refused))
+    {
+        slog(LOG_ALL, 0, "Reload of zone %s refused: %s", zone->getName(), refused);
+        return refused.empty() ? diku::format_to_str("The data file %s could not be read.", datafile) : refused;
+    }
+    rebind_templates(zone);
+    free_retired_templates();
+
+    if (!read_zone_reset_file(zone))
+    {
+        return diku::format_to_str("The reset file %s could not be read, the old resets are kept.", resetfile);
+    }
+
+    return "";
+}
+
 char *read_info_file(const char *name, char *oldstr)
 {
     char tmp[20 * MAX_STRING_LENGTH];
@@ -1820,6 +2158,9 @@ void boot_db()
     slog(LOG_OFF, 0, "Performing boot time reset.");
     reset_all_zones();
 
+    slog(LOG_OFF, 0, "Spreading out the heartbeats.");
+    heartbeat_dephase();
+
     touch_file(g_cServerConfig.getFileInLogDir(STATISTICS_FILE));
 }
 
@@ -47,6 +47,7 @@
 #define CRIME_NUM_FILE "crime_nr"
 #define CRIME_ACCUSE_FILE "crime"
 #define PLAYER_ID_NAME "players.id"
+#define SESSION_KEY_FILE "session.key" /* keys the sessions held by the mplex'ers */
 #define MAIL_FILE_NAME "mailbox.idx"
 #define MAIL_BLOCK_NAME "mailbox.blk"
 #define CREDITS_FILE "credits" /* for the 'credits' command  */
@@ -91,6 +92,7 @@ unit_data *read_unit(file_index_type *fi, int ins_list = TRUE);
 char *read_info_file(const char *name, char *oldstr);
 char *read_info_file(const std::string &name, char *oldstr);
 void boot_db();
+std::string reload_zone(zone_type *zone);
 void db_shutdown();
 int bread_affect(CByteBuffer *pBuf, unit_data *u, ubit8 nVersion);
 
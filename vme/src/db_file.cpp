@@ -11,6 +11,7 @@
 #include "dil.h"
 #include "dilrun.h"
 #include "dilshare.h"
+#include "dilstring.h"
 #include "error.h"
 #include "formatter.h"
 #include "handler.h"
@@ -279,6 +280,44 @@ diltemplate *bread_diltemplate(CByteBuffer *pBuf, int version)
     return tmpl;
 }
 
+/**
+ * Reads the optional source line table of a template, written by
+ * bwrite_dillines() after the template itself. Templates compiled
+ * without one (vmc -g) simply have nothing left in the buffer.
+ */
+void bread_dillines(CByteBuffer *pBuf, diltemplate *tmpl)
+{
+    tmpl->nLines = 0;
+    tmpl->lines = nullptr;
+    tmpl->nSamples = 0;
+    tmpl->lineSamples = nullptr;
+
+    if (pBuf->GetReadPosition() + sizeof(ubit32) > pBuf->GetLength())
+    {
+        return;
+    }
+
+    ubit32 n = pBuf->ReadU32();
+
+    if (n == 0 || (pBuf->GetLength() - pBuf->GetReadPosition()) / (2 * sizeof(ubit32)) < n)
+    {
+        slog(LOG_ALL, 0, "Ignoring corrupt line table in DIL template %s", tmpl->prgname);
+        pBuf->SetReadPosition(pBuf->GetLength());
+        return;
+    }
+
+    tmpl->nLines = n;
+    CREATE(tmpl->lines, ubit32, 2 * n);
+    for (ubit32 i = 0; i < 2 * n; i++)
+    {
+        tmpl->lines[i] = pBuf->ReadU32();
+    }
+
+#ifdef DMSERVER
+    CREATE(tmpl->lineSamples, ubit32, n);
+#endif
+}
+
 /** Reads DIL interrupt list */
 void bread_dilintr(CByteBuffer *pBuf, dilprg *prg, int version)
 {
@@ -568,8 +607,12 @@ void *bread_dil(CByteBuffer *pBuf, unit_data *owner, ubit8 version, unit_fptr *f
                 }
                 break;
             case DilVarType_e::DILV_SP:
-                pBuf->ReadStringAlloc(&prg->fp->vars[i].val.string);
-                break;
+            {
+                char *c = nullptr;
+                pBuf->SkipString(&c);
+                prg->fp->vars[i].val.string = str_is_empty(c) ? nullptr : dilstr_new(c);
+            }
+            break;
             case DilVarType_e::DILV_INT:
                 prg->fp->vars[i].val.integer = pBuf->ReadS32();
                 break;
@@ -1513,6 +1556,24 @@ void write_unit_datafile(FILE *f, unit_data *u, char *fname, const ubit32 filecr
     pBuf->FileWrite(f);
 }
 
+/**
+ * Writes the source line table of a template, if it has one. It must be
+ * the last thing in the buffer, see bread_dillines().
+ */
+void bwrite_dillines(CByteBuffer *pBuf, diltemplate *tmpl)
+{
+    if (tmpl->nLines == 0)
+    {
+        return;
+    }
+
+    pBuf->Append32(tmpl->nLines);
+    for (ubit32 i = 0; i < 2 * tmpl->nLines; i++)
+    {
+        pBuf->Append32(tmpl->lines[i]);
+    }
+}
+
 /**
  * Append template 'tmpl' to file 'f'
  * Used only by dmc. for writing zones
@@ -1531,6 +1592,7 @@ void write_diltemplate(FILE *f, diltemplate *tmpl, const ubit32 filecrc)
     pBuf->Append32(filecrc); // A unique crc (timestamp) for this file used to detect changes
     nStart = pBuf->GetLength();
     bwrite_diltemplate(pBuf, tmpl);
+    bwrite_dillines(pBuf, tmpl);
 
     /* We are now finished, and are positioned just beyond last data byte */
     length = pBuf->GetLength() - nStart;
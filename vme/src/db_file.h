@@ -14,6 +14,7 @@
 void *bread_dil(CByteBuffer *pBuf, unit_data *, ubit8 version, unit_fptr *fptr, int stspec = TRUE);
 
 diltemplate *bread_diltemplate(CByteBuffer *pBuf, int version);
+void bread_dillines(CByteBuffer *pBuf, diltemplate *tmpl);
 int bread_extra(CByteBuffer *pBuf, extra_list &cExtra, int unit_version);
 
 unit_fptr *bread_func(CByteBuffer *pBuf, ubit8 version, unit_data *owner, int stspec = TRUE);
@@ -25,6 +26,7 @@ void bwrite_func(CByteBuffer *pBuf, unit_fptr *fptr);
 void bwrite_block(FILE *f, int length, void *buffer);
 void bwrite_dil(CByteBuffer *pBuf, dilprg *prg);
 void bwrite_diltemplate(CByteBuffer *pBuf, diltemplate *tmpl);
+void bwrite_dillines(CByteBuffer *pBuf, diltemplate *tmpl);
 
 void write_unit_datafile(FILE *f, unit_data *u, char *fname, const ubit32 filecrc);
 void write_diltemplate(FILE *f, diltemplate *tmpl, const ubit32 filecrc);
@@ -4,6 +4,7 @@
 #include "comm.h"
 #include "db.h"
 #include "formatter.h"
+#include "handler.h"
 #include "json_helper.h"
 #include "main_functions.h"
 #include "nanny.h"
@@ -334,6 +335,7 @@ unit_data *descriptor_data::getCharacter()
 void descriptor_data::setCharacter(unit_data *value)
 {
     character = value;
+    descriptor_zone_update(this);
 }
 
 const unit_data *descriptor_data::cgetOriginalCharacter() const
@@ -351,6 +353,16 @@ void descriptor_data::setOriginalCharacter(unit_data *value)
     original = value;
 }
 
+zone_type *descriptor_data::getPresenceZone() const
+{
+    return presence;
+}
+
+void descriptor_data::setPresenceZone(zone_type *value)
+{
+    presence = value;
+}
+
 const snoop_data &descriptor_data::cgetSnoopData() const
 {
     return snoop;
@@ -8,6 +8,7 @@
 #include <ctime>
 
 class unit_data;
+class zone_type;
 
 class descriptor_data
 {
@@ -86,6 +87,9 @@ public:
     unit_data *getOriginalCharacter();
     void setOriginalCharacter(unit_data *value);
 
+    zone_type *getPresenceZone() const;
+    void setPresenceZone(zone_type *value);
+
     const snoop_data &cgetSnoopData() const;
     snoop_data &getSnoopData();
 
@@ -116,6 +120,7 @@ private:
     cQueue qInput;                          ///< q of unprocessed input
     unit_data *character{nullptr};          ///< linked to char
     unit_data *original{nullptr};           ///< original char
+    zone_type *presence{nullptr};           ///< zone the character is counted in
     snoop_data snoop;                       ///< to snoop people.
     descriptor_data *next{nullptr};         ///< link to next descriptor
 };
@@ -137,6 +137,79 @@ int basedestruct::destruct_classindex()
 
 /* ======================================= */
 
+void destruct_unit(unit_data *unit);
+
+#ifdef DMSERVER
+/*
+ * Tear down the contents of a unit that is about to be freed, while they
+ * are still in place. Objects were left inside by extract_unit(), only
+ * their functions and affects remain. Characters are destructed on their
+ * own as they can't go down with their container.
+ */
+static void destruct_contents_teardown(unit_data *unit)
+{
+    unit_data *next = nullptr;
+
+    for (unit_data *u = unit->getUnitContains(); u; u = next)
+    {
+        next = u->getNext();
+
+        if (u->isObj() && OBJ_EQP_POS(u))
+        {
+            unequip_object(u);
+        }
+
+        if (u->isChar())
+        {
+            destruct_unit(u);
+            continue;
+        }
+
+        stop_all_special(u);
+        stop_affect(u);
+
+        destruct_contents_teardown(u);
+
+        while (u->getFunctionPointer())
+        {
+            destroy_fptr(u, u->getFunctionPointer()); /* Unlinks, no free */
+        }
+
+        while (u->getUnitAffected())
+        {
+            unlink_affect(u->getUnitAffected());
+        }
+
+        if ((g_unit_list == u) || u->getGlobalNext() || u->getGlobalPrevious())
+        {
+            remove_from_unit_list(u);
+        }
+    }
+}
+
+/*
+ * Free the contents of a unit that has left the game. Nothing outside the
+ * unit refers to them any more, so they are freed without unlinking them
+ * one by one or adjusting the light and weight of their containers.
+ */
+static void destruct_contents_free(unit_data *unit)
+{
+    unit_data *u = nullptr;
+
+    while ((u = unit->getUnitContains()))
+    {
+        unit->setUnitContains(u->getNext());
+        u->setNext(nullptr);
+        u->setNextChar(nullptr);
+        u->setUnitIn(nullptr);
+
+        destruct_contents_free(u);
+        DELETE(unit_data, u);
+    }
+    unit->setCharContains(nullptr);
+}
+#endif
+
 /* May only be called by clear_destuct! */
 void destruct_unit(unit_data *unit)
 {
@@ -198,17 +271,22 @@ void destruct_unit(unit_data *unit)
         assert(FALSE);
     }
 
-    while (unit->getUnitContains())
+    if (in_menu)
     {
-        if (unit->getUnitContains()->isObj() && OBJ_EQP_POS(unit->getUnitContains()))
+        /* The player stays, so its contents have to be taken out properly */
+        while (unit->getUnitContains())
         {
-            unequip_object(unit->getUnitContains());
+            if (unit->getUnitContains()->isObj() && OBJ_EQP_POS(unit->getUnitContains()))
+            {
+                unequip_object(unit->getUnitContains());
+            }
+            destruct_unit(unit->getUnitContains());
         }
-        destruct_unit(unit->getUnitContains());
     }
-
-    if (!in_menu)
+    else
     {
+        destruct_contents_teardown(unit);
+
         /* Call functions of the unit which have any data                     */
         /* that they might want to work on.                                   */
         while (unit->getFunctionPointer())
@@ -226,6 +304,7 @@ void destruct_unit(unit_data *unit)
     {
         unit_from_unit(unit);
     }
+    unit_zone_settle(unit);
 
     if ((g_unit_list == unit) || unit->getGlobalNext() || unit->getGlobalPrevious())
     {
@@ -234,6 +313,7 @@ void destruct_unit(unit_data *unit)
 
     if (!in_menu)
     {
+        destruct_contents_free(unit);
         DELETE(unit_data, unit);
         unit = nullptr;
     }
@@ -270,6 +350,16 @@ void clear_destructed()
     }
     destructed_idx[DR_FUNC] = 0;
 
+    /* Units inside a destructed unit are freed along with it */
+    for (i = 0; i < destructed_idx[DR_UNIT]; i++)
+    {
+        auto *u = (unit_data *)destructed[DR_UNIT][i];
+        if (u && u->getUnitIn() && u->getUnitIn()->is_destructed())
+        {
+            destructed[DR_UNIT][i] = nullptr;
+        }
+    }
+
     for (i = 0; i < destructed_idx[DR_UNIT]; i++)
     {
         if ((unit_data *)destructed[DR_UNIT][i])
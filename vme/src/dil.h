@@ -15,6 +15,16 @@
 
 #define SKIP 0xffffffff /* skip label/index defined */
 
+/*
+ * The address operand of an IF or GOTO. vmc -O points a jump that lands
+ * on a GOTO straight at the final target, and keeps the number of GOTOs
+ * it skips in the top byte. They are charged to the program when the jump
+ * is taken, so it gets the same number of instructions before it yields.
+ */
+#define DIL_JUMP_ADR(a) ((a) & 0x00ffffff)
+#define DIL_JUMP_SKIPPED(a) ((a) >> 24)
+#define DIL_JUMP_MAXSKIP 32
+
 enum DilVarType_e : uint8_t
 {
     DILV_INVALID = 0,
@@ -500,13 +510,15 @@ enum class DilValAlloc_e : ubit8
 {
    NotAllocated  = 0,  // DILA_NONE, no malloc, e.g. INT
    GlobalPointer = 1,  // DILA_NORM, Pointer to e.g. a zone, should not be freed
-   Allocated     = 2   // DILA_EXP, allocated, e.g. a string malloc. Needs to be freed
+   Allocated     = 2,  // DILA_EXP, allocated, e.g. a string malloc. Needs to be freed
+   RefCounted    = 3   // DILA_STR, reference counted dilstr (string or string variable)
 };
 
 /* allocation strategy */
 #define DILA_NONE 0 /* not malloc (int) */
 #define DILA_NORM 1 /* Assignment of a pointer that should not be freed, e.g. a zone pointer */
 #define DILA_EXP 2  /* temp. expression malloc */
+#define DILA_STR 3  /* dilstr value or reference to a string variable, see dilstring.h */
 
 /* DIL evaluation result. */
 class dilval
@@ -579,6 +591,11 @@ struct diltemplate
     ubit32 nTriggers;     /* Number of triggers of the DIL   */
     double fCPU;          /* CPU usage (miliseconds)         */
 
+    ubit32 nLines;        /* Number of entries in lines            */
+    ubit32 *lines;        /* (core offset, source line) pairs, optional */
+    ubit32 nSamples;      /* Profiler samples taken in this DIL    */
+    ubit32 *lineSamples;  /* Profiler samples per lines entry      */
+
     dilprg *nextdude;     // For use in DIL sendtoall() with destroyed units
     dilprg *prg_list;     // Replacing the global dil_list with a template local one
     diltemplate *vmcnext; // Only for VMC
@@ -25,6 +25,8 @@ $Revision: 2.18 $
 #include "dilexp.h"
 #include "dilinst.h"
 #include "dilrun.h"
+#include "dilshare.h"
+#include "dilstring.h"
 #include "dilsup.h"
 #include "fight.h"
 #include "files.h"
@@ -69,6 +71,103 @@ $Revision: 2.18 $
 /* DIL-expressions							    */
 /* ************************************************************************ */
 
+/*
+ * Point the string variable referenced by v (DILV_SPR, DILA_STR) at a new
+ * dilstr copy of str. str may point into the old value.
+ */
+static void dil_strvar_set(dilval *v, const char *str)
+{
+    char *pOld = *((char **)v->ref);
+
+    *((char **)v->ref) = dilstr_new(str);
+    dilstr_free(pOld);
+}
+
+/*
+ * Lower or upper case the string value of v. When there is nothing to
+ * change (the common case) a dilstr is shared instead of copied.
+ */
+static char *dil_str_recase(const dilval *v, int (*needs)(int), int (*recase)(char *))
+{
+    const char *c = (const char *)v->val.ptr;
+
+    if (v->atyp == DILA_STR)
+    {
+        while (*c && !needs(*c))
+        {
+            c++;
+        }
+
+        if (*c == '\0')
+        {
+            return dilstr_ref((char *)v->val.ptr);
+        }
+    }
+
+    char *dest = dilstr_new((const char *)v->val.ptr, dil_str_len(v));
+    recase(dest);
+
+    return dest;
+}
+
+/*
+ * Replace all occurrences of the string value of sch with rpl in subj, like
+ * str_substitute(). Only allocates when something is replaced, otherwise a
+ * dilstr subject is shared. Lengths come from the dilstr headers.
+ */
+static char *dil_str_replace(const dilval *sch, const dilval *rpl, const dilval *subj)
+{
+    const char *s = STR((const char *)subj->val.ptr);
+    const char *f = (const char *)sch->val.ptr;
+    const char *r = STR((const char *)rpl->val.ptr);
+    size_t flen = dil_str_len(sch);
+    const char *c = nullptr;
+
+    if ((flen == 0) || (c = strstr(s, f)) == nullptr)
+    {
+        return subj->val.ptr ? dil_str_copy(subj) : dilstr_new("");
+    }
+
+    size_t rlen = dil_str_len(rpl);
+    size_t slen = dil_str_len(subj);
+    size_t n = 0;
+
+    for (const char *t = c; t; t = strstr(t + flen, f))
+    {
+        n++;
+    }
+
+    char *dest = dilstr_alloc(slen - n * flen + n * rlen);
+    char *d = dest;
+
+    for (; c; c = strstr(s, f))
+    {
+        memcpy(d, s, c - s);
+        d += c - s;
+        memcpy(d, r, rlen);
+        d += rlen;
+        s = c + flen;
+    }
+    strcpy(d, s);
+
+    return dest;
+}
+
+/* strcmp() of the lower cased strings, without lower casing copies of them */
+static int dil_strcmp_lower(const char *s1, const char *s2)
+{
+    for (;; s1++, s2++)
+    {
+        unsigned char c1 = isupper(*s1) ? tolower(*s1) : *s1;
+        unsigned char c2 = isupper(*s2) ? tolower(*s2) : *s2;
+
+        if ((c1 != c2) || (c1 == '\0'))
+        {
+            return c1 - c2;
+        }
+    }
+}
+
 void dilfe_illegal(dilprg *p)
 {
     szonelog(p->sarg->owner->getFileIndex()->getZone(),
@@ -123,14 +222,8 @@ void dilfe_replace(dilprg *p)
                         case DILV_SP:
                             if (v->type == DILV_SP)
                             {
-                                std::string sch((char *)v1->val.ptr);
-                                std::string rpl((char *)v2->val.ptr);
-                                std::string mystr((char *)v3->val.ptr);
-
-                                str_substitute(sch, rpl, mystr);
-
-                                v->atyp = DILA_EXP;
-                                v->val.ptr = str_dup(mystr.c_str());
+                                v->atyp = DILA_STR;
+                                v->val.ptr = dil_str_replace(v1, v2, v3);
                                 /*
                                 MS2020 This could crash if replacing multiple instances of string (buffer OOB)
                                 olen = strlen((char *)v1->val.ptr);
@@ -172,7 +265,6 @@ void dilfe_tolower(dilprg *p)
 {
     dilval *v = new dilval;
     dilval *v1 = p->stack.pop();
-    char *s1 = nullptr;
 
     v->type = DILV_SP;
 
@@ -192,10 +284,8 @@ void dilfe_tolower(dilprg *p)
             }
             else
             {
-                v->atyp = DILA_EXP;
-                s1 = str_dup((char *)v1->val.ptr);
-                str_lower(s1);
-                v->val.ptr = s1;
+                v->atyp = DILA_STR;
+                v->val.ptr = dil_str_recase(v1, isupper, str_lower);
             }
             break;
     }
@@ -208,7 +298,6 @@ void dilfe_toupper(dilprg *p)
 {
     dilval *v = new dilval;
     dilval *v1 = p->stack.pop();
-    char *s1 = nullptr;
 
     v->type = DILV_SP;
 
@@ -229,10 +318,8 @@ void dilfe_toupper(dilprg *p)
             }
             else
             {
-                v->atyp = DILA_EXP;
-                s1 = str_dup((char *)v1->val.ptr);
-                str_upper(s1);
-                v->val.ptr = s1;
+                v->atyp = DILA_STR;
+                v->val.ptr = dil_str_recase(v1, islower, str_upper);
             }
 
             break;
@@ -1787,11 +1874,18 @@ void dilfe_ldstr(dilprg *p)
                         v->val.num = load_string(filename.c_str(), &sstr);
                         if (!str_is_empty(sstr))
                         {
-                            if (*((char **)v2->ref))
+                            if (v2->atyp == DILA_STR)
                             {
-                                FREE(*((char **)v2->ref));
+                                dil_strvar_set(v2, sstr);
+                            }
+                            else
+                            {
+                                if (*((char **)v2->ref))
+                                {
+                                    FREE(*((char **)v2->ref));
+                                }
+                                *((char **)v2->ref) = str_dup(sstr);
                             }
-                            *((char **)v2->ref) = str_dup(sstr);
                             FREE(sstr);
                         }
                         else
@@ -3199,14 +3293,7 @@ void dilfe_len(dilprg *p)
         case DILV_SP:
             v->atyp = DILA_NONE;
             v->type = DILV_INT;
-            if (v1->val.ptr)
-            {
-                v->val.num = strlen((char *)v1->val.ptr);
-            }
-            else
-            {
-                v->val.num = 0;
-            }
+            v->val.num = dil_str_len(v1);
             break;
         case DILV_SLP:
             v->atyp = DILA_NONE;
@@ -3626,7 +3713,11 @@ void dilfe_getw(dilprg *p)
                 c = (char *)skip_spaces(c);
                 v->val.ptr = str_dup(buf1);
 
-                if (v1->atyp == DILA_NORM && v1->type == DILV_SPR)
+                if (v1->atyp == DILA_STR && v1->type == DILV_SPR)
+                {
+                    dil_strvar_set(v1, c);
+                }
+                else if (v1->atyp == DILA_NORM && v1->type == DILV_SPR)
                 {
                     memmove(*(char **)v1->ref, c, strlen(c) + 1);
                 }
@@ -4242,14 +4333,28 @@ void dilfe_plus(dilprg *p)
     switch (v->type)
     {
         case DILV_SP:
-            v->atyp = DILA_EXP;
-            CREATE(v->val.ptr, char, (strlen(STR((char *)v1->val.ptr)) + strlen(STR((char *)v2->val.ptr)) + 1));
-            strcpy((char *)v->val.ptr, STR((char *)v1->val.ptr));
-            strcat((char *)v->val.ptr, STR((char *)v2->val.ptr));
-            strcat((char *)v->val.ptr, "\0");
-            /*\\      v->val.ptr = str_dup(str_cc(STR((char *) v1->val.ptr),
-            \\				  STR((char *) v2->val.ptr))); */
-            break;
+        {
+            size_t l1 = dil_str_len(v1);
+            size_t l2 = dil_str_len(v2);
+
+            v->atyp = DILA_STR;
+            if ((l2 == 0) && v1->val.ptr && (v1->atyp == DILA_STR))
+            {
+                v->val.ptr = dilstr_ref((char *)v1->val.ptr); /* s + "" */
+            }
+            else if ((l1 == 0) && v2->val.ptr && (v2->atyp == DILA_STR))
+            {
+                v->val.ptr = dilstr_ref((char *)v2->val.ptr); /* "" + s */
+            }
+            else
+            {
+                char *dest = dilstr_alloc(l1 + l2);
+                memcpy(dest, STR((char *)v1->val.ptr), l1);
+                memcpy(dest + l1, STR((char *)v2->val.ptr), l2);
+                v->val.ptr = dest;
+            }
+        }
+        break;
 
         case DILV_INT:
             v->atyp = DILA_NONE;
@@ -5277,8 +5382,6 @@ void dilfe_slt(dilprg *p)
     /* Less Than operator */
     dilval *v2 = p->stack.pop();
     dilval *v1 = p->stack.pop();
-    char *s1 = nullptr;
-    char *s2 = nullptr;
     v->type = DILV_INT;
     switch (dil_getval(v2))
     {
@@ -5295,20 +5398,7 @@ void dilfe_slt(dilprg *p)
                     }
                     else
                     {
-                        s1 = str_dup((char *)v1->val.ptr);
-                        s2 = str_dup((char *)v2->val.ptr);
-                        str_lower(s1);
-                        str_lower(s2);
-                        if (strcmp(s1, s2) < 0)
-                        {
-                            v->val.num = TRUE;
-                        }
-                        else
-                        {
-                            v->val.num = FALSE;
-                        }
-                        FREE(s1);
-                        FREE(s2);
+                        v->val.num = (dil_strcmp_lower((char *)v1->val.ptr, (char *)v2->val.ptr) < 0);
                     }
                     break;
                 case DILV_FAIL:
@@ -5338,8 +5428,6 @@ void dilfe_sgt(dilprg *p)
     /* Less Than operator */
     dilval *v2 = p->stack.pop();
     dilval *v1 = p->stack.pop();
-    char *s1 = nullptr;
-    char *s2 = nullptr;
     v->type = DILV_INT;
     switch (dil_getval(v2))
     {
@@ -5356,20 +5444,7 @@ void dilfe_sgt(dilprg *p)
                     }
                     else
                     {
-                        s1 = str_dup((char *)v1->val.ptr);
-                        s2 = str_dup((char *)v2->val.ptr);
-                        str_lower(s1);
-                        str_lower(s2);
-                        if (strcmp(s1, s2) > 0)
-                        {
-                            v->val.num = TRUE;
-                        }
-                        else
-                        {
-                            v->val.num = FALSE;
-                        }
-                        FREE(s1);
-                        FREE(s2);
+                        v->val.num = (dil_strcmp_lower((char *)v1->val.ptr, (char *)v2->val.ptr) > 0);
                     }
                     break;
                 case DILV_FAIL:
@@ -5399,8 +5474,6 @@ void dilfe_sle(dilprg *p)
     /* Less Than operator */
     dilval *v2 = p->stack.pop();
     dilval *v1 = p->stack.pop();
-    char *s1 = nullptr;
-    char *s2 = nullptr;
     v->type = DILV_INT;
     switch (dil_getval(v2))
     {
@@ -5417,20 +5490,7 @@ void dilfe_sle(dilprg *p)
                     }
                     else
                     {
-                        s1 = str_dup((char *)v1->val.ptr);
-                        s2 = str_dup((char *)v2->val.ptr);
-                        str_lower(s1);
-                        str_lower(s2);
-                        if (strcmp(s1, s2) <= 0)
-                        {
-                            v->val.num = TRUE;
-                        }
-                        else
-                        {
-                            v->val.num = FALSE;
-                        }
-                        FREE(s1);
-                        FREE(s2);
+                        v->val.num = (dil_strcmp_lower((char *)v1->val.ptr, (char *)v2->val.ptr) <= 0);
                     }
                     break;
                 case DILV_FAIL:
@@ -5460,8 +5520,6 @@ void dilfe_sge(dilprg *p)
     /* Less Than operator */
     dilval *v2 = p->stack.pop();
     dilval *v1 = p->stack.pop();
-    char *s1 = nullptr;
-    char *s2 = nullptr;
     v->type = DILV_INT;
     switch (dil_getval(v2))
     {
@@ -5478,20 +5536,7 @@ void dilfe_sge(dilprg *p)
                     }
                     else
                     {
-                        s1 = str_dup((char *)v1->val.ptr);
-                        s2 = str_dup((char *)v2->val.ptr);
-                        str_lower(s1);
-                        str_lower(s2);
-                        if (strcmp(s1, s2) >= 0)
-                        {
-                            v->val.num = TRUE;
-                        }
-                        else
-                        {
-                            v->val.num = FALSE;
-                        }
-                        FREE(s1);
-                        FREE(s2);
+                        v->val.num = (dil_strcmp_lower((char *)v1->val.ptr, (char *)v2->val.ptr) >= 0);
                     }
                     break;
                 case DILV_FAIL:
@@ -5567,6 +5612,10 @@ void dilfe_se(dilprg *p)
             {
                 v->val.num = (str_is_empty((char *)v1->val.ptr) && str_is_empty((char *)v2->val.ptr));
             }
+            else if ((v1->atyp == DILA_STR) && (v2->atyp == DILA_STR) && (dil_str_len(v1) != dil_str_len(v2)))
+            {
+                v->val.num = FALSE; /* str_ccmp() only folds A-Z, lengths must match */
+            }
             else
             {
                 v->val.num = !str_ccmp((char *)v1->val.ptr, (char *)v2->val.ptr);
@@ -5635,6 +5684,10 @@ void dilfe_sne(dilprg *p)
             {
                 v->val.num = (!str_is_empty((char *)v1->val.ptr) || !str_is_empty((char *)v2->val.ptr));
             }
+            else if ((v1->atyp == DILA_STR) && (v2->atyp == DILA_STR) && (dil_str_len(v1) != dil_str_len(v2)))
+            {
+                v->val.num = TRUE; /* str_ccmp() only folds A-Z, lengths must match */
+            }
             else
             {
                 v->val.num = (str_ccmp((char *)v1->val.ptr, (char *)v2->val.ptr) != 0);
@@ -6290,7 +6343,11 @@ void dilfe_fndu2(dilprg *p)
         v->atyp = DILA_NORM;
         v->val.ptr = find_unit_dil((unit_data *)v1->val.ptr, &c, (unit_data *)v4->val.ptr, v3->val.num, v5->val.num);
 
-        if (v2->atyp == DILA_NORM && v2->type == DILV_SPR)
+        if (v2->atyp == DILA_STR && v2->type == DILV_SPR)
+        {
+            dil_strvar_set(v2, c);
+        }
+        else if (v2->atyp == DILA_NORM && v2->type == DILV_SPR)
         {
             memmove(v2->val.ptr, c, strlen(c) + 1);
         }
@@ -6434,7 +6491,11 @@ void dilfe_fndu(dilprg *p)
         v->atyp = DILA_NORM;
         v->val.ptr = find_unit_dil((unit_data *)v1->val.ptr, &c, (unit_data *)v4->val.ptr, v3->val.num);
 
-        if (v2->atyp == DILA_NORM && v2->type == DILV_SPR)
+        if (v2->atyp == DILA_STR && v2->type == DILV_SPR)
+        {
+            dil_strvar_set(v2, c);
+        }
+        else if (v2->atyp == DILA_NORM && v2->type == DILV_SPR)
         {
             memmove(v2->val.ptr, c, strlen(c) + 1);
         }
@@ -6624,7 +6685,7 @@ void dilfe_var(dilprg *p)
             v->ref = &(p->fp->vars[varno].val.cmdptr);
             break;
         case DILV_SP: /* string pointer */
-            v->atyp = DILA_NORM;
+            v->atyp = DILA_STR;
             v->type = DILV_SPR;
             v->ref = &(p->fp->vars[varno].val.string);
             break;
@@ -25,6 +25,8 @@
 #include "dil.h"
 #include "dilinst.h"
 #include "dilrun.h"
+#include "dilshare.h"
+#include "dilstring.h"
 #include "error.h"
 #include "files.h"
 #include "handler.h"
@@ -987,8 +989,8 @@ void dilfi_rtf(dilprg *p)
 
             case DILV_SP:
                 v->type = DILV_SP;
-                v->atyp = DILA_EXP;
-                v->val.ptr = str_dup((char *)v1->val.ptr);
+                v->atyp = DILA_STR;
+                v->val.ptr = dil_str_copy(v1);
                 break;
 
             case DILV_SLP:
@@ -1193,7 +1195,7 @@ void dil_push_frame(dilprg *p, diltemplate *rtmpl)
                 break;
 
             case DILV_SP:
-                frm->vars[i].val.string = str_dup((char *)p->stack[-(rtmpl->argc - i)]->val.ptr);
+                frm->vars[i].val.string = dil_str_copy(p->stack[-(rtmpl->argc - i)]);
                 break;
 
             case DILV_SLP:
@@ -1514,13 +1516,18 @@ void dilfi_ass(dilprg *p)
 
         /* string assignment */
         case DILV_SPR:
-            /* free potential old string */
-            if (v1->atyp == DILA_NORM)
-            {
-                if (*((char **)v1->ref))
-                    FREE(*((char **)v1->ref));
-            }
-            else
+        {
+            /*
+             * String variables hold reference counted dilstr's (DILA_STR),
+             * string fields on units etc. hold ordinary malloc'ed strings.
+             * Build the new value first, it may share the old one.
+             */
+            bool bDilStr = (v1->atyp == DILA_STR);
+            bool bFreeOld = bDilStr || (v1->atyp == DILA_NORM);
+            bool bAssign = true;
+            char *pNew = nullptr;
+
+            if (!bFreeOld)
             {
                 dil_typeerr(p, "ordinary string assignment <- hash");
             }
@@ -1528,40 +1535,57 @@ void dilfi_ass(dilprg *p)
             switch (dil_getval(v2))
             {
                 case DILV_FAIL:
+                    bAssign = false;
                     break;
 
                 case DILV_NULL:
-                    *((void **)v1->ref) = nullptr;
                     break;
 
                 case DILV_HASHSTR:
-                    if (v2->ref)
-                    {
-                        *((char **)v1->ref) = str_dup(((std::string *)v2->ref)->c_str());
-                    }
-                    else
-                    {
-                        *((char **)v1->ref) = str_dup("");
-                    }
-                    break;
+                {
+                    const char *c = v2->ref ? ((std::string *)v2->ref)->c_str() : "";
+                    pNew = bDilStr ? dilstr_new(c) : str_dup(c);
+                }
+                break;
 
                 case DILV_SP:
-                    if (v2->val.ptr)
+                    if (v2->val.ptr == nullptr)
                     {
-                        *((char **)v1->ref) = str_dup((const char *)v2->val.ptr);
+                        pNew = bDilStr ? dilstr_new("") : str_dup("");
                     }
                     else
                     {
-                        *((char **)v1->ref) = str_dup("");
+                        pNew = bDilStr ? dil_str_copy(v2) : str_dup((const char *)v2->val.ptr);
                     }
                     break;
 
                 default:
                     /* ERROR incompatible types */
                     dil_typeerr(p, "string assignment");
+                    bAssign = false;
                     break;
             }
-            break;
+
+            if (bAssign)
+            {
+                char *pOld = *((char **)v1->ref);
+
+                *((char **)v1->ref) = pNew;
+
+                if (pOld && bFreeOld)
+                {
+                    if (bDilStr)
+                    {
+                        dilstr_free(pOld);
+                    }
+                    else
+                    {
+                        FREE(pOld);
+                    }
+                }
+            }
+        }
+        break;
 
         case DILV_SLPR:
             /* String list assignment. The old stringlist is */
@@ -1930,8 +1954,9 @@ void dilfi_if(dilprg *p)
 
     p->waitcmd--;
     if (!dil_getbool(v1, p))
-    {                                              /* might be pointer, but ok! */
-        p->fp->pc = &(p->fp->tmpl->core[coreptr]); /* choose else branch */
+    {                                                            /* might be pointer, but ok! */
+        p->fp->pc = &(p->fp->tmpl->core[DIL_JUMP_ADR(coreptr)]); /* choose else branch */
+        p->waitcmd = MAX(0, p->waitcmd - (int)DIL_JUMP_SKIPPED(coreptr));
     }
     delete v1;
 }
@@ -2604,8 +2629,9 @@ void dilfi_goto(dilprg *p)
     ubit32 adr = 0;
 
     adr = bread_ubit32(&(p->fp->pc));
-    p->fp->pc = &(p->fp->tmpl->core[adr]);
+    p->fp->pc = &(p->fp->tmpl->core[DIL_JUMP_ADR(adr)]);
     p->waitcmd--;
+    p->waitcmd = MAX(0, p->waitcmd - (int)DIL_JUMP_SKIPPED(adr));
 }
 
 /* Goto new command */
@@ -0,0 +1,88 @@
+#include "dilprofile.h"
+
+#include "formatter.h"
+#include "zone_type.h"
+
+#include <string>
+
+ubit32 g_dil_profile_countdown = DIL_PROFILE_INTERVAL;
+
+/*
+ * Index of the line table entry the instruction at pc belongs to, the
+ * last entry starting at or before it. -1 if the template has no table.
+ */
+sbit32 dil_line_index(const diltemplate *tmpl, const ubit8 *pc)
+{
+    if (tmpl->nLines == 0)
+    {
+        return -1;
+    }
+
+    ubit32 adr = pc - tmpl->core;
+    ubit32 lo = 0;
+    ubit32 hi = tmpl->nLines;
+
+    while (hi - lo > 1)
+    {
+        ubit32 mid = (lo + hi) / 2;
+
+        if (tmpl->lines[2 * mid] <= adr)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+/* Source line of the instruction at pc, 0 if not known */
+ubit32 dil_source_line(const diltemplate *tmpl, const ubit8 *pc)
+{
+    sbit32 i = dil_line_index(tmpl, pc);
+
+    return (i < 0) ? 0 : tmpl->lines[2 * i + 1];
+}
+
+/*
+ * Take a sample of prg, which is about to execute the instruction before
+ * fp->pc. The call stack is folded as prg@zone:line frames separated by
+ * ';', outermost first, and credited to the zone of the outermost program.
+ */
+void dil_profile_sample(dilprg *prg)
+{
+    g_dil_profile_countdown = DIL_PROFILE_INTERVAL;
+
+    diltemplate *tmpl = prg->fp->tmpl;
+    sbit32 i = dil_line_index(tmpl, prg->fp->pc - 1);
+
+    tmpl->nSamples++;
+    if (i >= 0 && tmpl->lineSamples)
+    {
+        tmpl->lineSamples[i]++;
+    }
+
+    zone_type *zone = prg->frame[0].tmpl->zone;
+    if (zone == nullptr)
+    {
+        return;
+    }
+
+    std::string stack;
+    for (dilframe *f = prg->frame; f <= prg->fp; f++)
+    {
+        if (f != prg->frame)
+        {
+            stack += ';';
+        }
+        stack += diku::format_to_str("%s@%s:%u",
+                                     f->tmpl->prgname,
+                                     f->tmpl->zone ? f->tmpl->zone->getName().c_str() : "",
+                                     dil_source_line(f->tmpl, f->pc - 1));
+    }
+
+    zone->addDILProfileSample(stack);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "dil.h"
+
+/*
+ * Sampling profiler for DIL. Every DIL_PROFILE_INTERVAL instructions the
+ * interpreter records where the running program is: the template and, if
+ * the zone was compiled with vmc -g, the source line. The samples are kept
+ * per template (line hits) and per zone (folded call stacks), and are
+ * shown and reset with 'wstat zone <name> profile'.
+ */
+
+#define DIL_PROFILE_INTERVAL 1000 /* Instructions between two samples */
+
+extern ubit32 g_dil_profile_countdown;
+
+sbit32 dil_line_index(const diltemplate *tmpl, const ubit8 *pc);
+ubit32 dil_source_line(const diltemplate *tmpl, const ubit8 *pc);
+void dil_profile_sample(dilprg *prg);
+
+/* Count the instruction about to be executed by prg towards the next sample */
+inline void dil_profile_tick(dilprg *prg)
+{
+    if (--g_dil_profile_countdown == 0)
+    {
+        dil_profile_sample(prg);
+    }
+}
@@ -10,6 +10,8 @@
 #include "dil.h"
 #include "dilexp.h"
 #include "dilinst.h"
+#include "dilprofile.h"
+#include "dilstring.h"
 #include "error.h"
 #include "essential.h"
 #include "handler.h"
@@ -372,7 +374,7 @@ void dil_free_var(dilvar *v)
         case DilVarType_e::DILV_SP:
             if (v->val.string)
             {
-                FREE(v->val.string);
+                dilstr_free(v->val.string);
                 v->val.string = nullptr;
             }
             break;
@@ -467,6 +469,12 @@ void dil_free_template(diltemplate *tmpl, int copy)
         if (tmpl->core)
             FREE(tmpl->core);
 
+        if (tmpl->lines)
+            FREE(tmpl->lines);
+
+        if (tmpl->lineSamples)
+            FREE(tmpl->lineSamples);
+
         if (tmpl->extprg)
             FREE(tmpl->extprg);
 
@@ -1352,6 +1360,7 @@ static int check_interrupt(dilprg *prg)
             {
                 (prg)->fp->pc++;
                 (prg)->fp->tmpl->nInstructions++;
+                dil_profile_tick(prg);
                 assert(prg->fp->pc <= &(prg->fp->tmpl->core[prg->fp->tmpl->coresz]));
                 g_dil_runtime_function_table[*(prg->fp->pc - 1)](prg);
             }
@@ -1583,6 +1592,7 @@ int run_dil(spec_arg *sarg)
         (prg)->fp->pc++;
 
         (prg)->fp->tmpl->nInstructions++;
+        dil_profile_tick(prg);
 
         assert(prg->fp->pc <= &(prg->fp->tmpl->core[prg->fp->tmpl->coresz]));
 
@@ -1864,8 +1874,7 @@ int dil_direct_init(spec_arg *sarg)
                     {
                         if (tmpl->argt[i] == DilVarType_e::DILV_SP)
                         {
-                            prg->fp->vars[i].val.string = dilargs->dilarg[i].data.string;
-                            dilargs->dilarg[i].data.string = nullptr;
+                            prg->fp->vars[i].val.string = dilstr_new(dilargs->dilarg[i].data.string);
                         }
                         else if (tmpl->argt[i] == DilVarType_e::DILV_SLP)
                         {
@@ -2266,7 +2275,7 @@ dilprg *dil_copy(char *name, unit_data *u)
         {
             if (tmpl->argt[i] == DilVarType_e::DILV_SP)
             {
-                prg->fp->vars[i].val.string = str_dup(args[i]);
+                prg->fp->vars[i].val.string = dilstr_new(args[i]);
             }
             else if (tmpl->argt[i] == DilVarType_e::DILV_INT)
             {
@@ -7,6 +7,8 @@
 
 #include "dil.h"
 #include "dilrun.h"
+#include "dilshare.h"
+#include "dilstring.h"
 #include "intlist.h"
 #include "namelist.h"
 #include "slog.h"
@@ -59,6 +61,11 @@ dilval::~dilval()
                 FREE(val.ptr);
                 val.ptr = nullptr;
             }
+            else if (atyp == DILA_STR)
+            {
+                dilstr_free((char *)val.ptr);
+                val.ptr = nullptr;
+            }
             break;
 
         case DILV_SLP:
@@ -99,6 +106,41 @@ dilval::~dilval()
     }
 }
 
+/*
+ * Return a new dilstr reference to the string value of v (after dil_getval()).
+ * Strings that already are dilstr's are shared rather than copied.
+ */
+char *dil_str_copy(const dilval *v)
+{
+    if (v->val.ptr == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (v->atyp == DILA_STR)
+    {
+        return dilstr_ref((char *)v->val.ptr);
+    }
+
+    return dilstr_new((const char *)v->val.ptr);
+}
+
+/* Length of the string value of v, without a strlen() when it is a dilstr */
+size_t dil_str_len(const dilval *v)
+{
+    if (v->val.ptr == nullptr)
+    {
+        return 0;
+    }
+
+    if (v->atyp == DILA_STR)
+    {
+        return dilstr_len((const char *)v->val.ptr);
+    }
+
+    return strlen((const char *)v->val.ptr);
+}
+
 void dilprg::link(diltemplate *tmpl)
 {
     assert(this->next == nullptr);
@@ -1,6 +1,13 @@
 #pragma once
 
+#include <cstddef>
+
+class dilval;
+
 extern int g_nDilPrg;
 extern int g_nDilVal;
 
 DilVarType_e DilVarTypeIntToEnum(int n);
+
+char *dil_str_copy(const dilval *v);
+size_t dil_str_len(const dilval *v);
@@ -0,0 +1,107 @@
+#include "dilstring.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+struct dilstr_header
+{
+    ubit32 refs; /* number of owners of the string */
+    ubit32 len;  /* strlen() of the text that follows */
+};
+
+static inline dilstr_header *dilstr_head(const char *str)
+{
+    return (dilstr_header *)(str - sizeof(dilstr_header));
+}
+
+/*
+ * Allocate an uninitialised string of len characters (plus the NUL) with
+ * a reference count of one. The caller fills in the text before the
+ * string is handed to anyone else.
+ */
+char *dilstr_alloc(size_t len)
+{
+    dilstr_header *head = (dilstr_header *)malloc(sizeof(dilstr_header) + len + 1);
+
+    assert(head);
+    assert(len < 0xFFFFFFFF);
+
+    head->refs = 1;
+    head->len = (ubit32)len;
+
+    char *str = (char *)(head + 1);
+    str[len] = '\0';
+
+    return str;
+}
+
+char *dilstr_new(const char *str, size_t len)
+{
+    if (str == nullptr)
+    {
+        return nullptr;
+    }
+
+    char *dest = dilstr_alloc(len);
+    memcpy(dest, str, len);
+
+    return dest;
+}
+
+char *dilstr_new(const char *str)
+{
+    if (str == nullptr)
+    {
+        return nullptr;
+    }
+
+    return dilstr_new(str, strlen(str));
+}
+
+char *dilstr_ref(char *str)
+{
+    if (str)
+    {
+        dilstr_head(str)->refs++;
+    }
+
+    return str;
+}
+
+void dilstr_free(char *str)
+{
+    if (str == nullptr)
+    {
+        return;
+    }
+
+    dilstr_header *head = dilstr_head(str);
+
+    assert(head->refs > 0);
+
+    if (--head->refs == 0)
+    {
+        free(head);
+    }
+}
+
+size_t dilstr_len(const char *str)
+{
+    if (str == nullptr)
+    {
+        return 0;
+    }
+
+    return dilstr_head(str)->len;
+}
+
+ubit32 dilstr_refs(const char *str)
+{
+    if (str == nullptr)
+    {
+        return 0;
+    }
+
+    return dilstr_head(str)->refs;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "essential.h"
+
+#include <cstddef>
+
+/*
+ * Reference counted, immutable strings for DIL string values and string
+ * variables.
+ *
+ * A dilstr is an ordinary char * to NUL terminated text and can be read
+ * wherever a C string is read. The text is preceded by a small header that
+ * holds the reference count and the length, so handing a string on is
+ * dilstr_ref() (a counter increment) and its length is known without strlen().
+ *
+ * A dilstr must never be written to, FREE()'d or realloc()'d. Build a new
+ * one with dilstr_new() or dilstr_alloc() and drop references with
+ * dilstr_free(). A nullptr is a valid (empty) dilstr everywhere.
+ */
+
+char *dilstr_new(const char *str);
+char *dilstr_new(const char *str, size_t len);
+char *dilstr_alloc(size_t len);
+char *dilstr_ref(char *str);
+void dilstr_free(char *str);
+size_t dilstr_len(const char *str);
+ubit32 dilstr_refs(const char *str);
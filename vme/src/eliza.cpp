@@ -18,11 +18,14 @@
 #include "unit_fptr.h"
 #include "utils.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <queue>
+#include <vector>
 
 #define ELIZA_TALKFILE "talk.eli"
 #define ELIZA_LOGFILE "log.eli"
@@ -62,6 +65,162 @@ int eliza_maxkeywords = 0;
 
 int eliza_booted = FALSE;
 
+/*
+  Aho-Corasick automaton over every keyword of every eliza_keyword entry.
+  It is built once in eliza_boot() so trykeywd() can find all keywords
+  present in a line with a single pass over it, rather than calling
+  str_str() once for each keyword.
+
+  Keywords are numbered in the order trykeywd() used to test them (entry
+  by entry, keyword by keyword), so the matches can be replayed in that
+  order with the same priority and random tie-break rules.
+*/
+class keyword_matcher
+{
+public:
+    void build();
+    void match(const char *line, std::vector<int> &found) const;
+    int entry(int id) const { return m_entry[id]; }
+
+private:
+    int add_state();
+    int next(int state, unsigned char c) const { return m_goto[state * m_nclasses + m_class[c]]; }
+
+    std::vector<int> m_entry;            // Keyword id -> index into eliza_keyword
+    std::vector<int> m_goto;             // Complete transition table, m_nclasses per state
+    std::vector<std::vector<int>> m_out; // Keyword ids recognised when entering a state
+    int m_nclasses{1};                   // Class 0 is every byte that occurs in no keyword
+    int m_class[256]{};                  // Byte -> column in m_goto
+};
+
+static keyword_matcher eliza_matcher;
+
+int keyword_matcher::add_state()
+{
+    m_goto.resize(m_goto.size() + m_nclasses, -1);
+    m_out.emplace_back();
+    return m_out.size() - 1;
+}
+
+void keyword_matcher::build()
+{
+    m_entry.clear();
+    m_goto.clear();
+    m_out.clear();
+    m_nclasses = 1;
+    memset(m_class, 0, sizeof(m_class));
+
+    /* Only bytes used by some keyword need a column of their own */
+    for (int j = 0; j < eliza_maxkeywords; j++)
+    {
+        for (int mi = 0; eliza_keyword[j].keyword[mi]; mi++)
+        {
+            for (const char *c = eliza_keyword[j].keyword[mi]; *c; c++)
+            {
+                if (m_class[(unsigned char)*c] == 0)
+                {
+                    m_class[(unsigned char)*c] = m_nclasses++;
+                }
+            }
+        }
+    }
+
+    add_state(); /* The root */
+
+    /* Build the trie, -1 marks a missing edge */
+    for (int j = 0; j < eliza_maxkeywords; j++)
+    {
+        for (int mi = 0; eliza_keyword[j].keyword[mi]; mi++)
+        {
+            int id = m_entry.size();
+            m_entry.push_back(j);
+
+            const char *c = eliza_keyword[j].keyword[mi];
+            if (!*c)
+            {
+                continue; /* An empty keyword is never matched */
+            }
+
+            int state = 0;
+            for (; *c; c++)
+            {
+                int col = state * m_nclasses + m_class[(unsigned char)*c];
+                if (m_goto[col] == -1)
+                {
+                    int ns = add_state();
+                    m_goto[col] = ns;
+                }
+                state = m_goto[col];
+            }
+            m_out[state].push_back(id);
+        }
+    }
+
+    /* Breadth first: compute failure links and turn the trie into a complete DFA */
+    std::vector<int> fail(m_out.size(), 0);
+    std::queue<int> todo;
+
+    for (int cl = 0; cl < m_nclasses; cl++)
+    {
+        int &s = m_goto[cl];
+        if (s == -1)
+        {
+            s = 0;
+        }
+        else
+        {
+            fail[s] = 0;
+            todo.push(s);
+        }
+    }
+
+    while (!todo.empty())
+    {
+        int state = todo.front();
+        todo.pop();
+
+        const auto &inherited = m_out[fail[state]];
+        m_out[state].insert(m_out[state].end(), inherited.begin(), inherited.end());
+
+        for (int cl = 0; cl < m_nclasses; cl++)
+        {
+            int &s = m_goto[state * m_nclasses + cl];
+            int f = m_goto[fail[state] * m_nclasses + cl];
+            if (s == -1)
+            {
+                s = f;
+            }
+            else
+            {
+                fail[s] = f;
+                todo.push(s);
+            }
+        }
+    }
+}
+
+/* Store the (sorted, unique) ids of all keywords occurring in line in found */
+void keyword_matcher::match(const char *line, std::vector<int> &found) const
+{
+    found.clear();
+
+    if (m_out.empty())
+    {
+        return;
+    }
+
+    int state = 0;
+
+    for (const char *c = line; *c; c++)
+    {
+        state = next(state, *c);
+        found.insert(found.end(), m_out[state].begin(), m_out[state].end());
+    }
+
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+}
+
 static char words[400];
 
 /* ============================================================= */
@@ -473,27 +632,25 @@ char *response(oracle_data *od, int subjno)
 /* the line does not match a template.  are there any keywords in it */
 int trykeywd(char *line, int *score)
 {
+    static std::vector<int> found;
     int j = 0;
     int index = 0;
-    int mi = 0;
 
     index = -1;
     *score = -1;
 
-    for (j = 0; j < eliza_maxkeywords; j++)
+    eliza_matcher.match(line, found);
+
+    for (int id : found)
     {
-        for (mi = 0; eliza_keyword[j].keyword[mi]; mi++)
+        j = eliza_matcher.entry(id);
+
+        if (eliza_keyword[j].priority >= *score)
         {
-            if (str_str(line, eliza_keyword[j].keyword[mi]) != nullptr)
+            if ((eliza_keyword[j].priority > *score) || number(0, 1))
             {
-                if (eliza_keyword[j].priority >= *score)
-                {
-                    if ((eliza_keyword[j].priority > *score) || number(0, 1))
-                    {
-                        *score = eliza_keyword[j].priority;
-                        index = j;
-                    }
-                }
+                *score = eliza_keyword[j].priority;
+                index = j;
             }
         }
     }
@@ -1108,6 +1265,8 @@ void eliza_boot()
 
     fclose(f);
 
+    eliza_matcher.build();
+
     /* eliza_integrity(); I know it's ok now... Use once when mod. talk.eli */
 
     slog(LOG_ALL, 0, "Booting Eliza Done.");
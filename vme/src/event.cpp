@@ -163,18 +163,10 @@ void eventqueue::remove(void (*func)(void *, void *), void *arg1, void *arg2)
     int i = 0;
     if ((func == special_event) && arg2 && (((unit_fptr *)arg2)->getEventQueue()))
     {
+        heartbeat_unschedule(((unit_fptr *)arg2)->getEventQueue());
         ((unit_fptr *)arg2)->getEventQueue()->func = nullptr;
         ((unit_fptr *)arg2)->setEventQueue(nullptr);
     }
-    else if ((func == affect_beat) && arg1 && (((unit_affected_type *)arg1)->cgetEventQueueElement()))
-    {
-        ((unit_affected_type *)arg1)->getEventQueueElement()->func = nullptr;
-        ((unit_affected_type *)arg1)->setEventQueueElement(nullptr);
-    }
-    else if ((func == affect_beat) && arg1 && (!((unit_affected_type *)arg1)->cgetEventQueueElement()))
-    {
-        return;
-    }
     else if ((func == special_event) && arg2 && (!((unit_fptr *)arg2)->getEventQueue()))
     {
         return;
@@ -387,6 +379,10 @@ void eventqueue::process()
                         {
                             pname = "Zone Reset Event";
                         }
+                        else if (tfunc == zone_reset_event)
+                        {
+                            pname = "Zone Reset Slice Event";
+                        }
                         else
                         {
                             pname = "UNKNOWN Event";
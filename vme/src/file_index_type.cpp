@@ -155,9 +155,16 @@ ubit32 file_index_type::getCRC() const
     return m_crc;
 }
 
-sbit16 file_index_type::getNumInZone() const
+sbit16 file_index_type::getNumInZone(const zone_type *zone) const
 {
-    return m_no_in_zone;
+    for (auto &[z, n] : m_no_in_zone)
+    {
+        if (z == zone)
+        {
+            return n;
+        }
+    }
+    return 0;
 }
 
 ubit16 file_index_type::getRoomNum() const
@@ -206,14 +213,22 @@ void file_index_type::DecrementNumInMemory()
     }
 }
 
-void file_index_type::IncrementNumInZone()
-{
-    ++m_no_in_zone;
-}
-
-void file_index_type::setNumInZone(sbit16 value)
+void file_index_type::changeNumInZone(const zone_type *zone, sbit16 delta)
 {
-    m_no_in_zone = value;
+    // Nearly always just the zone of the file index, so a short vector
+    for (auto it = m_no_in_zone.begin(); it != m_no_in_zone.end(); ++it)
+    {
+        if (it->first == zone)
+        {
+            it->second += delta;
+            if (it->second == 0)
+            {
+                m_no_in_zone.erase(it);
+            }
+            return;
+        }
+    }
+    m_no_in_zone.emplace_back(zone, delta);
 }
 
 void file_index_type::setLength(ubit32 value)
@@ -283,7 +298,7 @@ void file_index_type::toJSON(rapidjson::PrettyWriter<rapidjson::StringBuffer> &w
         json::write_kvp("filepos", m_filepos, writer);
         json::write_kvp("length", m_length, writer);
         json::write_kvp("crc", m_crc, writer);
-        json::write_kvp("no_in_zone", m_no_in_zone, writer);
+        json::write_kvp("no_in_zone", getNumInZone(m_zone), writer);
         json::write_kvp("no_in_mem", m_no_in_mem, writer);
         json::write_kvp("room_no", m_room_no, writer);
         json::write_kvp("type", m_type, writer);
@@ -6,6 +6,8 @@
 #include <cstring>
 #include <forward_list>
 #include <string>
+#include <utility>
+#include <vector>
 
 class unit_data;
 class zone_type;
@@ -13,6 +15,8 @@ class zone_type;
 /* A linked sorted list of all units within a zone file */
 class file_index_type
 {
+    using ZoneCounts = std::vector<std::pair<const zone_type *, sbit16>>;
+
 public:
     file_index_type(zone_type *zone, const char *name, ubit8 type);
     ~file_index_type() = default;                                 ///< Default dtor
@@ -30,7 +34,11 @@ public:
     [[nodiscard]] long getFilepos() const;
     [[nodiscard]] ubit32 getLength() const;
     [[nodiscard]] ubit32 getCRC() const;
-    [[nodiscard]] sbit16 getNumInZone() const;
+    /**
+     * @param zone Zone to count in
+     * @return Number of units of this file index in the zone, see unit_zone()
+     */
+    [[nodiscard]] sbit16 getNumInZone(const zone_type *zone) const;
     [[nodiscard]] ubit16 getNumInMem() const;
     [[nodiscard]] ubit16 getRoomNum() const;
     [[nodiscard]] ubit8 getType() const;
@@ -45,14 +53,18 @@ public:
     void IncrementNumInMemory();
     void DecrementNumInMemory();
 
-    void IncrementNumInZone();
+    /**
+     * Kept up to date by the handler when units enter or leave a zone
+     * @param zone The zone entered or left
+     * @param delta 1 when entered, -1 when left
+     */
+    void changeNumInZone(const zone_type *zone, sbit16 delta);
 
     /**
      * @param value Name to set
      * @param to_lower If true convert to lower case
      */
     void setCRC(ubit32 value);
-    void setNumInZone(sbit16 value);
     void setLength(ubit32 value);
     void setFilepos(long value);
     void setRoomNum(ubit16 value);
@@ -66,7 +78,7 @@ private:
     long m_filepos{0};                             ///< Byte offset into file
     ubit32 m_length{0};                            ///< No of bytes to read
     ubit32 m_crc{0};                               ///< CRC check for compressed items
-    sbit16 m_no_in_zone{0};                        ///< Updated in zone reset for reset
+    ZoneCounts m_no_in_zone{};                     ///< Number of these in each zone they are in
     ubit16 m_no_in_mem{0};                         ///< Number of these in the game
     ubit16 m_room_no{0};                           ///< The number of the room
     ubit8 m_type{0};                               ///< Room/Obj/Char or other?
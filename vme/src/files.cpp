@@ -453,6 +453,24 @@ FILE *fopen_cache(const std::string &name, const char *mode)
     return fopen_cache(name.c_str(), mode);
 }
 
+/* Close and forget a single file in the cache, e.g. one that was replaced on disk */
+void fclose_cache(const char *name)
+{
+    for (int i = 0; i < FCACHE_MAX; i++)
+    {
+        if (fcache[i].name && !strcmp(name, fcache[i].name))
+        {
+            if (fcache[i].file && fclose(fcache[i].file) != 0)
+            {
+                slog(LOG_ALL, 0, "fcache close failed on file %s.", fcache[i].name);
+            }
+            fcache[i].file = nullptr;
+            fcache[i].name[0] = '\0';
+            fcache[i].hits = 0;
+        }
+    }
+}
+
 void fclose_cache()
 {
     int i = 0;
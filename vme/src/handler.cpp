@@ -45,6 +45,107 @@ descriptor_data *unit_is_edited(unit_data *u)
     return nullptr;
 }
 
+/* The zone of a unit at the top level, only rooms are in a zone */
+static zone_type *top_unit_zone(const unit_data *top)
+{
+    return (top->isRoom() && top->getFileIndex()) ? top->getFileIndex()->getZone() : nullptr;
+}
+
+/* The zone the units in 'top' are counted in, which a lifted unit has left */
+static zone_type *top_counted_zone(const unit_data *top)
+{
+    return top->getLiftedZone() ? top->getLiftedZone() : top_unit_zone(top);
+}
+
+/*
+ * Count the character of the descriptor in the zone it is in, or in no zone
+ * when it isn't playing. Called whenever the character of the descriptor
+ * changes, enters or leaves the game or moves to another zone, so that
+ * zone_type::getNumOfPlayers() never has to look at the descriptors.
+ */
+void descriptor_zone_update(descriptor_data *d)
+{
+    zone_type *zone = nullptr;
+
+    if (descriptor_is_playing(d))
+    {
+        const unit_data *top = d->cgetCharacter();
+        while (top->getUnitIn())
+        {
+            top = top->getUnitIn();
+        }
+        zone = top_counted_zone(top);
+    }
+
+    if (zone != d->getPresenceZone())
+    {
+        if (d->getPresenceZone())
+        {
+            d->getPresenceZone()->decrementNumOfPlayers();
+        }
+        if (zone)
+        {
+            zone->incrementNumOfPlayers();
+        }
+        d->setPresenceZone(zone);
+    }
+}
+
+/* The unit entered or left the game or moved, recount its descriptor */
+static void unit_presence_update(unit_data *unit)
+{
+    if (unit->isChar() && CHAR_DESCRIPTOR(unit))
+    {
+        descriptor_zone_update(CHAR_DESCRIPTOR(unit));
+    }
+}
+
+/*
+ * A unit and everything inside it moved from zone 'from' to zone 'to'
+ * (either may be nullptr for no zone). Keeps the number of units of each
+ * file index in a zone up to date, see zone_limit(), and the players
+ * present in each zone. The zone only changes when a unit leaves or
+ * enters the top level, see unit_data::getLiftedZone().
+ */
+static void unit_zone_moved(unit_data *unit, const zone_type *from, const zone_type *to)
+{
+    if (from == to)
+    {
+        return;
+    }
+
+    for (unit_data *u = unit->getUnitContains(); u; u = u->getNext())
+    {
+        unit_zone_moved(u, from, to);
+    }
+
+    unit_presence_update(unit);
+
+    if (unit->getFileIndex() && !unit->isRoom())
+    {
+        if (from)
+        {
+            unit->getFileIndex()->changeNumInZone(from, -1);
+        }
+        if (to)
+        {
+            unit->getFileIndex()->changeNumInZone(to, 1);
+        }
+    }
+}
+
+/* A unit lifted to the top level has left the game, count it in no zone */
+void unit_zone_settle(unit_data *unit)
+{
+    zone_type *from = unit->getLiftedZone();
+
+    if (from)
+    {
+        unit->setLiftedZone(nullptr);
+        unit_zone_moved(unit, from, nullptr);
+    }
+}
+
 /* By using this, we can easily sort the list if ever needed */
 void insert_in_unit_list(unit_data *u)
 {
@@ -65,6 +166,7 @@ void insert_in_unit_list(unit_data *u)
         g_npc_head = u;
         g_room_head = u;
         g_obj_head = u;
+        unit_presence_update(u);
         return;
     }
 
@@ -174,6 +276,8 @@ void insert_in_unit_list(unit_data *u)
             break;
         }
     }
+
+    unit_presence_update(u);
 }
 
 /* Remove a unit from the g_unit_list */
@@ -181,6 +285,8 @@ void remove_from_unit_list(unit_data *unit)
 {
     assert(unit->getGlobalPrevious() || unit->getGlobalNext() || (g_unit_list == unit));
 
+    unit_zone_settle(unit);
+
     if (unit->getFileIndex())
     {
         unit->getFileIndex()->Remove(unit);
@@ -214,6 +320,8 @@ void remove_from_unit_list(unit_data *unit)
 
     unit->setGlobalNext(nullptr);
     unit->setGlobalPrevious(nullptr);
+
+    unit_presence_update(unit);
 }
 
 unit_fptr *find_fptr(unit_data *u, ubit16 idx)
@@ -728,6 +836,60 @@ unit_data *unit_room(unit_data *unit)
     return nullptr;
 }
 
+/*
+ * The chars inside a unit are also linked in a list of their own. Units
+ * always enter in front of the contents, so entering in front of the char
+ * list keeps both lists in the same order. The unit outside a non char
+ * counts it as a char holder while it has any chars inside.
+ */
+static void unit_chars_link(unit_data *unit, unit_data *to)
+{
+    if (unit->isChar())
+    {
+        if (to->getCharContains() == nullptr && !to->isChar() && to->getUnitIn())
+        {
+            to->getUnitIn()->incrementNumberOfCharacterHoldersInsideUnit();
+        }
+        unit->setNextChar(to->getCharContains());
+        to->setCharContains(unit);
+    }
+    else if (unit->getCharContains())
+    {
+        to->incrementNumberOfCharacterHoldersInsideUnit();
+    }
+}
+
+static void unit_chars_unlink(unit_data *unit, unit_data *from)
+{
+    unit_data *u = nullptr;
+
+    if (unit->isChar())
+    {
+        if (unit == from->getCharContains())
+        {
+            from->setCharContains(unit->getNextChar());
+        }
+        else
+        {
+            for (u = from->getCharContains(); u->getNextChar() != unit; u = u->getNextChar())
+            {
+                ;
+            }
+            u->setNextChar(unit->getNextChar());
+        }
+        unit->setNextChar(nullptr);
+
+        if (from->getCharContains() == nullptr && !from->isChar() && from->getUnitIn())
+        {
+            from->getUnitIn()->decrementNumberOfCharacterHoldersInsideUnit();
+        }
+    }
+    else if (unit->getCharContains())
+    {
+        from->decrementNumberOfCharacterHoldersInsideUnit();
+    }
+}
+
 void intern_unit_up(unit_data *unit, ubit1 pile)
 {
     unit_data *u = nullptr;
@@ -788,17 +950,28 @@ void intern_unit_up(unit_data *unit, ubit1 pile)
     }
 
     unit->setNext(nullptr);
+    unit_chars_unlink(unit, unit->getUnitIn());
 
     unit->setUnitIn(unit->getUnitIn()->getUnitIn());
     if (unit->getUnitIn())
     {
         unit->setNext(unit->getUnitIn()->getUnitContains());
         unit->getUnitIn()->setUnitContains(unit);
+        unit_chars_link(unit, unit->getUnitIn());
         if (unit->isChar())
         {
             unit->getUnitIn()->incrementNumberOfCharactersInsideUnit();
         }
     }
+    else if (unit->isRoom())
+    {
+        unit_zone_moved(unit, top_counted_zone(in), top_unit_zone(unit));
+    }
+    else
+    {
+        /* Recounted when it enters a unit again, usually in the same zone */
+        unit->setLiftedZone(top_counted_zone(in));
+    }
 
     if (pile && IS_MONEY(unit) && unit->getUnitIn())
     {
@@ -875,11 +1048,21 @@ void intern_unit_down(unit_data *unit, unit_data *to, ubit1 pile)
             }
             u->setNext(unit->getNext());
         }
+        unit_chars_unlink(unit, unit->getUnitIn());
     }
 
     unit->setUnitIn(to);
     unit->setNext(to->getUnitContains());
     to->setUnitContains(unit);
+    unit_chars_link(unit, to);
+
+    if (!in)
+    {
+        zone_type *from = top_counted_zone(unit);
+
+        unit->setLiftedZone(nullptr);
+        unit_zone_moved(unit, from, top_counted_zone(to));
+    }
 
     if (unit->isChar())
     {
@@ -1115,9 +1298,13 @@ void extract_unit(unit_data *unit)
     stop_all_special(unit);
     stop_affect(unit);
 
-    while (unit->getUnitContains())
+    /* Objects stay inside and are freed together with the unit, other
+       units move out. Restart when the list changed under us. */
+    unit_data *u = unit->getUnitContains();
+    while (u)
     {
-        extract_unit(unit->getUnitContains());
+        extract_unit(u);
+        u = (u->getUnitIn() == unit) ? u->getNext() : unit->getUnitContains();
     }
 
     /*	void unlink_affect(class unit_affected_type *af);
@@ -1147,6 +1334,13 @@ void extract_unit(unit_data *unit)
       remove_from_unit_list(unit);
     }*/
 
+    if (!unit->isChar() && unit->getUnitIn() && unit->getUnitIn()->is_destructed())
+    {
+        /* Freed along with its container by destruct_unit() */
+        remove_from_unit_list(unit);
+        return;
+    }
+
     if (unit->getUnitIn())
     {
         unit_from_unit(unit);
@@ -1160,6 +1354,10 @@ void extract_unit(unit_data *unit)
         // Players are already removed from the list in gstate_tomenu()
         remove_from_unit_list(unit);
     }
+    else
+    {
+        unit_zone_settle(unit);
+    }
 }
 
 /* ***********************************************************************
@@ -20,6 +20,7 @@ extra_descr_data *quest_add(unit_data *ch, const char *name, const char *descr);
 
 void insert_in_unit_list(unit_data *u);
 void remove_from_unit_list(unit_data *unit);
+void descriptor_zone_update(descriptor_data *d);
 
 unit_fptr *find_fptr(unit_data *u, ubit16 index);
 unit_fptr *create_fptr(unit_data *u, ubit16 index, ubit16 priority, ubit16 beat, ubit16 flags, void *data);
@@ -49,6 +50,7 @@ void unit_up(unit_data *unit);
 void unit_from_unit(unit_data *unit);
 void unit_down(unit_data *unit, unit_data *to);
 void unit_to_unit(unit_data *unit, unit_data *to);
+void unit_zone_settle(unit_data *unit);
 
 void extract_unit(unit_data *unit);
 
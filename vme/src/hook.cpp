@@ -16,6 +16,7 @@
 #include <sys/time.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cerrno>
 #include <csignal>
@@ -358,21 +359,29 @@ void cHook::Write(ubit8 *pData, ubit32 nLen, int bCopy)
 }
 
 // For this hook, read as much as we can from the network
-// into the Hook's Rx queue...
+// into the Hook's Rx buffer...
 // -1 on error, 0 on ok.
 //
-int cHook::ReadToQueue()
+int cHook::ReadToBuffer()
 {
-    char buf[4 * 1460 - 6];
     int thisround = 0;
 
     for (;;)
     {
-        thisround = this->read(buf, sizeof(buf)-1);
+        ubit8 *buf = bufRX.Reserve(4 * 1460);
+        int room = (int)bufRX.Space();
+
+        thisround = this->read(buf, room);
 
         if (thisround > 0)
         {
-            qRX.Append(new cQueueElem((ubit8 *)buf, (ubit32)thisround));
+            bufRX.Commit((ubit32)thisround);
+
+            if (thisround < room)
+            {
+                // Drained the socket, select() tells us when there is more
+                return 0;
+            }
         }
         else if (thisround == 0)
         {
@@ -384,7 +393,7 @@ int cHook::ReadToQueue()
             // will now be closed and error logged
             if (IsHooked())
             {
-                slog(LOG_ALL, 0, "ReadToQueue: Still hooked even though error - not possible");
+                slog(LOG_ALL, 0, "ReadToBuffer: Still hooked even though error - not possible");
             }
             return -1;
         }
@@ -393,6 +402,95 @@ int cHook::ReadToQueue()
     return 0;
 }
 
+/* ------------------------------------------------------------------- */
+/*                            RX BUFFER                                */
+/* ------------------------------------------------------------------- */
+
+cRxBuffer::cRxBuffer()
+{
+    pData = nullptr;
+    nSize = 0;
+    nHead = 0;
+    nTail = 0;
+}
+
+cRxBuffer::~cRxBuffer()
+{
+    if (pData)
+    {
+        FREE(pData);
+    }
+}
+
+// Make room for at least nLen more bytes at the tail and return where
+// they go. Call Commit() with the number of bytes actually written.
+//
+ubit8 *cRxBuffer::Reserve(ubit32 nLen)
+{
+    if (nSize - nTail >= nLen)
+    {
+        return pData + nTail;
+    }
+
+    if (nHead > 0)
+    {
+        ubit32 n = Bytes();
+
+        memmove(pData, pData + nHead, n);
+        nHead = 0;
+        nTail = n;
+    }
+
+    if (nSize - nTail < nLen)
+    {
+        ubit32 nNew = std::max(2 * nSize, nTail + nLen);
+
+        if (pData)
+        {
+            RECREATE(pData, ubit8, nNew);
+        }
+        else
+        {
+            CREATE(pData, ubit8, nNew);
+        }
+        nSize = nNew;
+    }
+
+    return pData + nTail;
+}
+
+void cRxBuffer::Commit(ubit32 nLen)
+{
+    assert(nTail + nLen <= nSize);
+    nTail += nLen;
+}
+
+void cRxBuffer::CutCopy(ubit8 *data, ubit32 nLen)
+{
+    assert(nLen <= Bytes());
+    memcpy(data, pData + nHead, nLen);
+    Cut(nLen);
+}
+
+void cRxBuffer::Cut(ubit32 nLen)
+{
+    assert(nLen <= Bytes());
+    nHead += nLen;
+
+    // Rewinding an empty buffer is free and saves a memmove later on
+    if (nHead == nTail)
+    {
+        nHead = 0;
+        nTail = 0;
+    }
+}
+
+void cRxBuffer::Flush()
+{
+    nHead = 0;
+    nTail = 0;
+}
+
 /* ------------------------------------------------------------------- */
 /*                            CAPTAIN HOOK                             */
 /* ------------------------------------------------------------------- */
@@ -458,7 +556,7 @@ void cCaptainHook::Hook(int nHandle, cHook *hook)
     hook->id = newid++;
 
     hook->qTX.Flush();
-    hook->qRX.Flush();
+    hook->bufRX.Flush();
 
     nIdx[nTop] = nHandle;
 
@@ -498,7 +596,7 @@ void cCaptainHook::Unhook(cHook *hook)
     // pfHook[nHandle]->fd = -1; // This should get unset in Unhook on close()
     pfHook[nHandle]->id = -1;
     pfHook[nHandle]->qTX.Flush();
-    pfHook[nHandle]->qRX.Flush();
+    pfHook[nHandle]->bufRX.Flush();
     pfHook[nHandle] = nullptr;
 
     nMax = 0;
@@ -23,6 +23,39 @@
 
 class cCaptainHook;
 
+// Receive buffer of a hook. Everything read from the socket is appended at
+// the tail and consumed from the head, so buffered frames are always
+// contiguous and can be parsed in place. When the tail runs out of room the
+// unconsumed bytes (usually just a partial frame) are moved to the front,
+// and the buffer only grows when that is not enough.
+//
+class cRxBuffer
+{
+public:
+    cRxBuffer();
+    ~cRxBuffer();
+
+    cRxBuffer(const cRxBuffer &) = delete;
+    cRxBuffer &operator=(const cRxBuffer &) = delete;
+
+    ubit32 Bytes() const { return nTail - nHead; }
+    const ubit8 *Data() const { return pData + nHead; }
+
+    ubit8 *Reserve(ubit32 nLen);
+    ubit32 Space() const { return nSize - nTail; }
+    void Commit(ubit32 nLen);
+
+    void CutCopy(ubit8 *data, ubit32 nLen);
+    void Cut(ubit32 nLen);
+    void Flush();
+
+private:
+    ubit8 *pData;
+    ubit32 nSize; ///< Allocated bytes
+    ubit32 nHead; ///< First unconsumed byte
+    ubit32 nTail; ///< One past the last received byte
+};
+
 // 2020
 //
 // This is really what the basic Hook class should have looked like in 1998.
@@ -62,9 +95,9 @@ public:
     virtual void Unhook();
 
     virtual void Write(ubit8 *pData, ubit32 nLen, int bCopy = TRUE);
-    int ReadToQueue();
+    int ReadToBuffer();
 
-    cQueue qRX;
+    cRxBuffer bufRX;
 
 protected:
     void PushWrite();
@@ -6,6 +6,7 @@
 #include "error.h"
 #include "files.h"
 #include "main_functions.h"
+#include "nanny.h"
 #include "protocol.h"
 #include "slog.h"
 #include "system.h"
@@ -85,6 +86,30 @@ void cMultiHook::Ping()
     protocol_send_ping(this);
 }
 
+void cMultiHook::AddDescriptor(descriptor_data *d)
+{
+    assert(d->getMultiHookPtr() == this);
+    m_descriptors[d->getMultiHookID()] = d;
+}
+
+void cMultiHook::RemoveDescriptor(descriptor_data *d)
+{
+    auto it = m_descriptors.find(d->getMultiHookID());
+
+    // The ids wrap around, so only drop the entry if it is still ours
+    if (it != m_descriptors.end() && it->second == d)
+    {
+        m_descriptors.erase(it);
+    }
+}
+
+descriptor_data *cMultiHook::FindDescriptor(ubit16 id) const
+{
+    auto it = m_descriptors.find(id);
+
+    return it == m_descriptors.end() ? nullptr : it->second;
+}
+
 void cMultiHook::Unhook()
 {
     if (this->IsHooked())
@@ -127,14 +152,7 @@ int cMultiHook::Read()
 
     if (id != 0)
     {
-        for (d = g_descriptor_list; d; d = d->getNext())
-        {
-            if (d->getMultiHookID() == id)
-            {
-                assert(d->getMultiHookPtr() == this);
-                break;
-            }
-        }
+        d = FindDescriptor(id);
 
         if (d == nullptr)
         {
@@ -156,6 +174,7 @@ int cMultiHook::Read()
         }
         else
         {
+            assert(d->getMultiHookPtr() == this);
             succ_err = 0;
         }
     }
@@ -192,6 +211,41 @@ int cMultiHook::Read()
             send_to_descriptor("By what name do they call you? ", d);
             break;
 
+        case MULTI_RESUME_CHAR:
+            // "cookie port line host name hash", the cookie is sent back so
+            // the mplex'er knows which of its connections got the new id
+            if (id == 0 && data)
+            {
+                char cookie[20] = "";
+                char host[50] = "";
+                char name[50] = "";
+                char hash[120] = "";
+                int port = 0;
+                int line = 0;
+
+                d = descriptor_new(this);
+
+                if (sscanf(data, "%19s %d %d %49s %49s %119s", cookie, &port, &line, host, name, hash) != 6)
+                {
+                    *cookie = '\0';
+                }
+
+                protocol_send_resume(this, d->getMultiHookID(), cookie);
+                d->setMplexPortNum(port);
+                d->setSerialLine(line);
+                d->setHostname(host);
+                send_to_descriptor("<mud-init/>", d);
+
+                if (!*cookie || !nanny_resume(d, name, hash))
+                {
+                    send_to_descriptor(g_cServerConfig.getLogo(), d);
+                    send_to_descriptor("By what name do they call you? ", d);
+                }
+            }
+            if (data)
+                FREE(data);
+            break;
+
         case MULTI_HOST_CHAR:
             if (d && data)
             {
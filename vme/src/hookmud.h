@@ -2,6 +2,10 @@
 
 #include "hook.h"
 
+#include <unordered_map>
+
+class descriptor_data;
+
 #define MAX_MULTI 10 /* Maximum five multiconnects */
 
 class cMultiHook : public cHook
@@ -15,8 +19,15 @@ public:
     int Read();
     void Ping();
 
+    void AddDescriptor(descriptor_data *d);
+    void RemoveDescriptor(descriptor_data *d);
+    descriptor_data *FindDescriptor(ubit16 id) const;
+
     int succ_err; ///< Number of successive errors
     ubit8 bWebsockets;
+
+private:
+    std::unordered_map<ubit16, descriptor_data *> m_descriptors; ///< Descriptors on this mplex by multi hook id
 };
 
 class cMultiMaster
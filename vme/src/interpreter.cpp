@@ -12,6 +12,7 @@
 #include "db.h"
 #include "descriptor_data.h"
 #include "dilrun.h"
+#include "dilstring.h"
 #include "mobact.h"
 #include "slog.h"
 #include "spec_assign.h"
@@ -21,8 +22,10 @@
 #include "unitfind.h"
 #include "utils.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
 
 trie_type *g_intr_trie = nullptr;
 
@@ -269,6 +272,74 @@ void dump_debug_history(void)
 }
 #endif
 
+/* Charges the time until it goes out of scope to the command */
+class command_timer
+{
+public:
+    explicit command_timer(command_info *cmd)
+        : m_cmd(cmd)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &m_begin);
+    }
+
+    ~command_timer()
+    {
+        timespec end;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        ubit64 usec = (end.tv_sec - m_begin.tv_sec) * 1000000 + (end.tv_nsec - m_begin.tv_nsec) / 1000;
+        command_stats &st = m_cmd->stats;
+        int bucket = 0;
+
+        for (ubit64 limit = 10; usec >= limit && bucket < CMD_STAT_BUCKETS - 1; limit *= 10)
+        {
+            bucket++;
+        }
+
+        st.calls++;
+        st.total_usec += usec;
+        st.max_usec = std::max(st.max_usec, (ubit32)std::min<ubit64>(usec, 0xFFFFFFFF));
+        st.histogram[bucket]++;
+    }
+
+private:
+    command_info *m_cmd;
+    timespec m_begin;
+};
+
+/* The commands that have been run, most expensive (total time) first */
+std::vector<command_info *> command_stats_top(size_t nCount)
+{
+    std::vector<command_info *> top;
+
+    for (command_info *cmd = g_cmdlist; cmd; cmd = cmd->next)
+    {
+        if (cmd->stats.calls > 0)
+        {
+            top.push_back(cmd);
+        }
+    }
+
+    std::sort(top.begin(), top.end(), [](const command_info *a, const command_info *b) {
+        return a->stats.total_usec > b->stats.total_usec;
+    });
+
+    if (top.size() > nCount)
+    {
+        top.resize(nCount);
+    }
+
+    return top;
+}
+
+void command_stats_clear()
+{
+    for (command_info *cmd = g_cmdlist; cmd; cmd = cmd->next)
+    {
+        memset(&cmd->stats, 0, sizeof(cmd->stats));
+    }
+}
+
 void command_interpreter(unit_data *ch, const char *cmdArg)
 {
     char cmd[MAX_INPUT_LENGTH + 10];
@@ -407,6 +478,8 @@ void command_interpreter(unit_data *ch, const char *cmdArg)
         }
     }
 
+    command_timer timer(cmd_ptr);
+
     if (*cmd)
     {
         if (cmd_ptr->excmd)
@@ -486,7 +559,7 @@ void command_interpreter(unit_data *ch, const char *cmdArg)
         if (prg)
         {
             prg->waitcmd = WAITCMD_MAXINST - 1; // The usual hack, see db_file
-            prg->fp->vars[0].val.string = str_dup(argstr);
+            prg->fp->vars[0].val.string = dilstr_new(argstr);
             dil_activate_cmd(prg, cmd_ptr);
         }
     }
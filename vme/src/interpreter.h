@@ -14,6 +14,8 @@
 
 #include <vme.h>
 
+#include <vector>
+
 class command_info;
 
 struct spec_arg
@@ -31,6 +33,17 @@ struct spec_arg
     ubit32 mflags; ///< Would like to make constant, but then can't define..
 };
 
+#define CMD_STAT_BUCKETS 8 ///< Latency decades: <10us, <100us, <1ms, <10ms, <100ms, <1s, <10s, 10s+
+
+/** Usage and cost of a command, updated by command_interpreter() */
+struct command_stats
+{
+    ubit32 calls;                       ///< Number of times the command was run
+    ubit64 total_usec;                  ///< Total wall time, including nested commands
+    ubit32 max_usec;                    ///< Slowest single run
+    ubit32 histogram[CMD_STAT_BUCKETS]; ///< Number of runs by decade of microseconds
+};
+
 struct command_info
 {
     ubit8 combat_speed;  ///< The speed of a combat command
@@ -55,6 +68,7 @@ struct command_info
     command_info *prev;
     char *excmd;
     char *excmdc;
+    command_stats stats;
 };
 
 /* Bitmasks to determine what kind of messages is to be send
@@ -82,6 +96,8 @@ ubit1 cmd_is_abbrev(unit_data *ch, const command_info *cmd);
 void wrong_position(unit_data *ch);
 void command_interpreter(unit_data *ch, const char *cmdArg);
 void argument_interpreter(const char *argument, char *first_arg, char *second_arg);
+std::vector<command_info *> command_stats_top(size_t nCount);
+void command_stats_clear();
 ///@}
 
 /* The routine to check for special routines */
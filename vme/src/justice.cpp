@@ -12,6 +12,7 @@
 #include "common.h"
 #include "db.h"
 #include "dilrun.h"
+#include "dilstring.h"
 #include "handler.h"
 #include "interpreter.h"
 #include "money.h"
@@ -92,7 +93,7 @@ void npc_walkto(class unit_data *u, class unit_data *toroom)
    if (prg)
    {
       prg->waitcmd = WAITCMD_MAXINST - 1;
-      prg->fp->vars[0].val.string = str_dup(buf);
+      prg->fp->vars[0].val.string = dilstr_new(buf);
       //prg->fp->vars[0].val.unitptr  = toroom; why didn't this work?
       dil_activate(prg);
    }
@@ -197,7 +198,7 @@ void log_crime(unit_data *criminal, unit_data *victim, ubit8 crime_type, int act
         prg->fp->vars[2].val.integer = crime_serial_no;
         prg->fp->vars[3].val.integer = crime_type;
         prg->fp->vars[4].val.integer = active;
-        prg->fp->vars[5].val.string = str_dup(victim->getNames().Name());
+        prg->fp->vars[5].val.string = dilstr_new(victim->getNames().Name());
         dil_add_secure(prg, criminal, prg->fp->tmpl->core);
         dil_add_secure(prg, victim, prg->fp->tmpl->core);
         dil_activate(prg);
@@ -221,7 +222,7 @@ void log_crime(unit_data *criminal, unit_data *victim, ubit8 crime_type, int act
                 prg2->fp->vars[2].val.integer = crime_serial_no;
                 prg2->fp->vars[3].val.integer = crime_type;
                 prg2->fp->vars[4].val.integer = active;
-                prg2->fp->vars[5].val.string = str_dup(victim->getNames().Name());
+                prg2->fp->vars[5].val.string = dilstr_new(victim->getNames().Name());
                 dil_add_secure(prg2, criminal, prg2->fp->tmpl->core);
                 dil_add_secure(prg2, UVI(i), prg2->fp->tmpl->core);
                 dil_activate(prg2);
@@ -250,7 +251,7 @@ void log_crime(unit_data *criminal, unit_data *victim, ubit8 crime_type, int act
                         prg3->fp->vars[2].val.integer = crime_serial_no;
                         prg3->fp->vars[3].val.integer = crime_type;
                         prg3->fp->vars[4].val.integer = active;
-                        prg3->fp->vars[5].val.string = str_dup(victim->getNames().Name());
+                        prg3->fp->vars[5].val.string = dilstr_new(victim->getNames().Name());
                         dil_add_secure(prg3, criminal, prg3->fp->tmpl->core);
                         dil_add_secure(prg3, UVI(j), prg3->fp->tmpl->core);
                         dil_activate(prg3);
@@ -482,7 +483,7 @@ void set_witness(class unit_data *criminal, class unit_data *witness,
             prg->waitcmd = WAITCMD_MAXINST - 1;
 
             prg->fp->vars[1].val.integer = type;
-            prg->fp->vars[2].val.string = str_dup(UNIT_NAME(criminal));
+            prg->fp->vars[2].val.string = dilstr_new(UNIT_NAME(criminal));
 
             dil_activate(prg);
         }
@@ -20,6 +20,135 @@
 #include "utils.h"
 #include "zone_reset.h"
 
+/*
+ * Units loaded together, at boot or by the same zone reset, would all tick
+ * in the same tic forever. So each heartbeat is put in the least busy tic
+ * within a tolerance of its due tic. The histogram counts the heartbeats
+ * due in each of the coming tics, a slot belongs to the tic it was last
+ * counted for and is stale for any other. There are enough slots for the
+ * longest heartbeat a unit_fptr can hold, randomised by half, so no two
+ * pending heartbeats are ever counted in the same slot.
+ */
+#define HB_SLOTS (1 << 17)      // A power of two
+#define HB_TOLERANCE(beat) MIN((beat) / 8, PULSE_SEC)
+
+struct heartbeat_slot
+{
+    int tic;
+    int count;
+};
+
+static_assert(HB_SLOTS > 0xFFFF + 0xFFFF / 2, "A heartbeat must not wrap around the histogram");
+
+static heartbeat_slot g_hb_load[HB_SLOTS];
+
+static int heartbeat_load(int tic)
+{
+    heartbeat_slot &s = g_hb_load[tic & (HB_SLOTS - 1)];
+
+    return s.tic == tic ? s.count : 0;
+}
+
+static void heartbeat_adjust(int tic, int n)
+{
+    heartbeat_slot &s = g_hb_load[tic & (HB_SLOTS - 1)];
+
+    if (s.tic != tic)
+    {
+        s.tic = tic;
+        s.count = 0;
+    }
+    s.count = MAX(0, s.count + n);
+}
+
+/* Number of tics from now to the least busy tic in ticks +/- tolerance, the nearest wins a tie */
+static int heartbeat_pick(int ticks, int tolerance)
+{
+    int best = ticks;
+    int best_load = heartbeat_load(g_tics + ticks);
+
+    for (int i = 1; i <= tolerance && best_load > 0; i++)
+    {
+        for (int t : {ticks - i, ticks + i})
+        {
+            if (t >= 1 && heartbeat_load(g_tics + t) < best_load)
+            {
+                best = t;
+                best_load = heartbeat_load(g_tics + t);
+            }
+        }
+    }
+
+    return best;
+}
+
+/* Schedule the next heartbeat, spread out unless the function wants it random */
+static void heartbeat_schedule(unit_data *u, unit_fptr *fptr, int ticks)
+{
+    if (fptr->isActivateOnEventFlagSet(SFB_RANTIME))
+    {
+        ticks = number(ticks - ticks / 2, ticks + ticks / 2);
+    }
+    else
+    {
+        ticks = heartbeat_pick(ticks, HB_TOLERANCE(ticks));
+    }
+
+    heartbeat_adjust(g_tics + ticks, 1);
+    fptr->setEventQueue(g_events.add(ticks, special_event, u, fptr));
+}
+
+/* Take a pending heartbeat out of the histogram, eventqueue::remove() calls it for every cancelled special_event */
+void heartbeat_unschedule(eventq_elem *e)
+{
+    if (e && e->func == special_event && e->when > g_tics)
+    {
+        heartbeat_adjust(e->when, -1);
+    }
+}
+
+/*
+ * Everything is started in the same tic at boot. Move each pending
+ * heartbeat to the least busy tic within its first period, so they start
+ * out of phase.
+ */
+void heartbeat_dephase()
+{
+    int n = 0;
+
+    for (unit_data *u = g_unit_list; u; u = u->getGlobalNext())
+    {
+        for (unit_fptr *fptr = u->getFunctionPointer(); fptr; fptr = fptr->getNext())
+        {
+            eventq_elem *e = fptr->getEventQueue();
+            int beat = fptr->getHeartBeat();
+
+            if (e == nullptr || e->func != special_event || beat < PULSE_SEC || fptr->is_destructed())
+            {
+                continue;
+            }
+
+            g_events.remove(special_event, u, fptr);
+
+            int ticks = heartbeat_pick((beat + 1) / 2, (beat - 1) / 2);
+            heartbeat_adjust(g_tics + ticks, 1);
+            fptr->setEventQueue(g_events.add(ticks, special_event, u, fptr));
+            n++;
+        }
+    }
+
+    slog(LOG_ALL, 0, "Spread %d heartbeats over their first period.", n);
+}
+
+/* Heartbeats counted for each of the next 'tics' tics */
+void heartbeat_report(int tics, int *pLoad)
+{
+    for (int i = 0; i < tics; i++)
+    {
+        pLoad[i] = heartbeat_load(g_tics + 1 + i);
+    }
+}
+
 void SetFptrTimer(unit_data *u, unit_fptr *fptr)
 {
     ubit32 ticks = 0;
@@ -46,16 +175,11 @@ void SetFptrTimer(unit_data *u, unit_fptr *fptr)
             fptr->setHeartBeat(PULSE_SEC * 3);
         }
 
-        if (fptr->isActivateOnEventFlagSet(SFB_RANTIME))
-        {
-            ticks = number(ticks - ticks / 2, ticks + ticks / 2);
-        }
         if (fptr->getEventQueue())
         {
             g_events.remove(special_event, u, fptr);
         }
-        fptr->setEventQueue(g_events.add(ticks, special_event, u, fptr));
-        //      g_events.add(ticks, special_event, u, fptr);
+        heartbeat_schedule(u, fptr, ticks);
         membug_verify_class(fptr);
         membug_verify(fptr->data);
     }
@@ -143,12 +267,7 @@ void special_event(void *p1, void *p2)
     {
         return;
     }
-    if (fptr->getEventQueue())
-    {
-        fptr->getEventQueue()->func = nullptr;
-    }
-
-    fptr->setEventQueue(nullptr);
+    g_events.remove(special_event, u, fptr);
     priority = FALSE;
 
     for (ftmp = u->getFunctionPointer(); ftmp; ftmp = ftmp->getNext())
@@ -307,7 +426,7 @@ void start_special(unit_data *u, unit_fptr *fptr)
 
         if (!u->is_destructed() && !fptr->is_destructed())
         {
-            fptr->setEventQueue(g_events.add(fptr->getHeartBeat(), special_event, u, fptr));
+            heartbeat_schedule(u, fptr, fptr->getHeartBeat());
         }
     }
 }
@@ -3,6 +3,9 @@
 #include "unit_data.h"
 #include "unit_fptr.h"
 
+void heartbeat_dephase();
+void heartbeat_unschedule(eventq_elem *e);
+void heartbeat_report(int tics, int *pLoad);
 void ResetFptrTimer(unit_data *u, unit_fptr *fptr);
 void SetFptrTimer(unit_data *u, unit_fptr *fptr);
 void special_event(void *p1, void *p2);
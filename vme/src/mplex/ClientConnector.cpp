@@ -161,6 +161,18 @@ void cConHook::MudDown(const char *cmd)
     test_mud_up(); // Wonder if I have multi threading issues here :o)
 }
 
+void dumbResume(cConHook *con, const char *cmd)
+{
+    con->Resume(cmd);
+}
+
+// Waiting to be put back into the game after the MUD restarted
+void cConHook::Resume(const char *cmd)
+{
+    auto buf = diku::format_to_str("Please wait, putting you back into %s.<br/>", g_mudname);
+    SendCon(buf);
+}
+
 void Idle(cConHook *con, const char *cmd)
 {
     /* This should not happen, but I am tryng to find a bug... */
@@ -262,7 +274,7 @@ void cConHook::Write(ubit8 *pData, ubit32 nLen, int bCopy)
     if (this->m_pWebsServer)
     {
         assert(pData[nLen] == 0);
-        if (!ws_send_message(m_pWebsServer, m_pWebsHdl, (const char *)pData))
+        if (!ws_send_message(m_pWebsServer, m_pWebsHdl, (const char *)pData, &m_sWsStats))
         {
             this->Close(TRUE);
         }
@@ -299,6 +311,29 @@ void cConHook::Close(int bNotifyMud)
     m_pFptr = Idle;
     m_nId = 0;
 
+    if (m_pWebsServer)
+    {
+        if (m_sWsStats.deflated)
+        {
+            slog(LOG_OFF,
+                 0,
+                 "Websocket %s sent %llu messages, %llu bytes deflated to %llu.",
+                 m_aHost,
+                 (unsigned long long)m_sWsStats.messages,
+                 (unsigned long long)m_sWsStats.bytes,
+                 (unsigned long long)m_sWsStats.deflated);
+        }
+        else
+        {
+            slog(LOG_OFF,
+                 0,
+                 "Websocket %s sent %llu messages, %llu bytes uncompressed.",
+                 m_aHost,
+                 (unsigned long long)m_sWsStats.messages,
+                 (unsigned long long)m_sWsStats.bytes);
+        }
+        m_sWsStats = ws_stats();
+    }
     m_pWebsServer = nullptr;
 
     remove_gmap(this);
@@ -604,13 +639,13 @@ void cConHook::SendCon(const std::string &text)
 
 /* ======================= TEXT FORMATTING OUTPUT ====================== */
 
-std::string mplex_getcolor(cConHook *hook, const char *colorstr)
+const std::string &mplex_getcolor(cConHook *hook, const char *colorstr)
 {
-    auto gcolor = hook->color.get(colorstr);
+    const std::string &gcolor = hook->color.get(colorstr);
 
     if (gcolor.empty())
     {
-        gcolor = g_cDefcolor.get(colorstr);
+        return g_cDefcolor.get(colorstr);
     }
 
     return gcolor;
@@ -683,7 +718,7 @@ char *cConHook::IndentText(const char *source, char *dest, int dest_size, int wi
                     protocol_translate(this, *current, &newptr);
                     if (*current == CONTROL_COLOR_END_CHAR)
                     {
-                        auto mplex_color = mplex_getcolor(this, tmpbuf);
+                        const auto &mplex_color = mplex_getcolor(this, tmpbuf);
                         if (mplex_color.empty() == false)
                         {
                             auto cretbuf = mplex_color.begin();
@@ -1447,8 +1482,6 @@ void cConHook::ShowChunk()
     Write((ubit8 *)buffer, strlen(buffer));
 }
 
-typedef websocketpp::server<websocketpp::config::asio> wsserver;
-
 // Nice if it could be in the constructor
 void cConHook::SetWebsocket(wsserver *server, websocketpp::connection_hdl hdl)
 {
@@ -1497,6 +1530,9 @@ cConHook::cConHook()
         m_sSetup.emulation = TERM_TTY;
     }
 
+    static ubit32 nCookies = 0;
+    m_nCookie = ++nCookies;
+
     m_sSetup.height = 15;
     m_sSetup.width = 80;
     m_sSetup.colour_convert = 0;
@@ -1509,33 +1545,13 @@ cConHook::cConHook()
     m_pFptr = dumbMenuSelect;
     m_nPromptMode = 0;
     strcpy(m_aHost, "");
+}
 
-    if (g_mplex_arg.bWebSockets)
-    {
-        return; // Hack for making websockets work
-    }
-
-    int fd = 0;
-#ifdef _WINDOWS
-    int j;
-    int size;
-#else
-    unsigned int j = 0;
-    unsigned int size = 0;
-#endif
-    sockaddr_in conaddr;
-    sockaddr_in sock;
-    char hostname[49];
+// Take over a socket accepted on the mother connection
+void cConHook::Accept(int fd, const char *pcHost)
+{
     int x = 0;
 
-    assert(g_MotherHook.IsHooked());
-
-    j = sizeof(conaddr);
-    // slog(LOG_OFF, 0, "accept() before.");
-    fd = accept(g_MotherHook.tfd(), (sockaddr *)&conaddr, &j);
-    // slog(LOG_OFF, 0, "accept() after.");
-    Assert(fd >= 0, "ACCEPT");
-
 #ifdef LINUX
     x = fcntl(fd, F_SETFL, FNDELAY);
     Assert(x != -1, "Non blocking set error.");
@@ -1552,46 +1568,7 @@ cConHook::cConHook()
        if (j == -1)
        error(HERE, "No Setsockopt()"); */
 
-    size = sizeof(sock);
-    if (getpeername(fd, (sockaddr *)&sock, &size) == -1)
-    {
-        slog(LOG_OFF, 0, "getpeername: socket %d error no %d.", fd, errno);
-        // MS2020 strncpy (hostname,"NO GETPEERNAME",strlen("NO GETPEERNAME")+1);
-        strcpy(hostname, "NO GETPEERNAME");
-    }
-    else
-    {
-        /*
-           This occasionally causes freezing (for all players) of a duration
-           from ~1 - 60 seconds. Too bad... if I get threads I will put it back
-           in, I hate having only the numeric address. Quinn suggested an
-           alarm of a few seconds, I'll try that out.
-         */
-
-        /*alarm(1); */
-
-        /*
-           if ((from = gethostbyaddr((char*) &sock.sin_addr,
-           sizeof(sock.sin_addr),
-           AF_INET)) == NULL)
-           {
-           slog(LOG_ALL, 0, "No symbolic INET address, h_errno %d.", h_errno);
-           addr = (unsigned char *) &sock.sin_addr.s_addr;
-        strncpy (hostname,inet_ntoa(sock.sin_addr),49);
-           }
-           else
-           {
-           m_aHostname = (char *) from->h_name;
-           }
-         */
-        /* alarm(0); unschedule alarm */
-
-        /* The fix */
-        //      addr = (unsigned char *) &sock.sin_addr.s_addr;
-        strncpy(hostname, inet_ntoa(sock.sin_addr), sizeof(hostname) - 1);
-    }
-
-    strncpy(m_aHost, hostname, sizeof(m_aHost) - 1);
+    strncpy(m_aHost, pcHost, sizeof(m_aHost) - 1);
     *(m_aHost + sizeof(m_aHost) - 1) = '\0';
 
     if (this->tfd() != -1)
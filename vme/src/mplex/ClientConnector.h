@@ -14,14 +14,58 @@
 #include "queue.h"
 
 #include <cstring>
+#include <string>
 #include <websocketpp/config/asio_no_tls.hpp>
+#include <websocketpp/extensions/permessage_deflate/enabled.hpp>
 #include <websocketpp/server.hpp>
 
 namespace mplex
 {
 
+/// Websocket output of one connection
+struct ws_stats
+{
+    ubit64 messages{0}; ///< Messages sent
+    ubit64 bytes{0};    ///< Payload bytes handed to websocketpp
+    ubit64 deflated{0}; ///< The same payloads after permessage-deflate, 0 when not negotiated
+};
+
+/// The connection whose message is being compressed, set around each send
+extern thread_local ws_stats *g_ws_sending;
+
+/**
+ * permessage-deflate as websocketpp implements it, counting the compressed
+ * bytes for the connection sending. The context takeover and window sizes
+ * are whatever the client offers.
+ */
+template <typename config>
+class ws_deflate : public websocketpp::extensions::permessage_deflate::enabled<config>
+{
+public:
+    websocketpp::lib::error_code compress(std::string const &in, std::string &out)
+    {
+        size_t before = out.size();
+        auto ec = websocketpp::extensions::permessage_deflate::enabled<config>::compress(in, out);
+
+        if (g_ws_sending)
+        {
+            g_ws_sending->deflated += out.size() - before;
+        }
+        return ec;
+    }
+};
+
+/// The asio config with permessage-deflate, clients not offering it are sent plain frames
+struct deflate_config : public websocketpp::config::asio
+{
+    struct permessage_deflate_config
+    {
+    };
+    typedef ws_deflate<permessage_deflate_config> permessage_deflate_type;
+};
+
 // typedef websocketpp::server<websocketpp::config::asio> wsserver;
-typedef websocketpp::server<websocketpp::config::asio> wsserver;
+typedef websocketpp::server<deflate_config> wsserver;
 
 class cConHook : public cHook
 {
@@ -29,6 +73,8 @@ public:
     cConHook();
     ~cConHook();
 
+    void Accept(int fd, const char *pcHost);
+
     void Unhook();
     int IsHooked(); ///< At this level we also need to check for websockets
     void Write(ubit8 *pData, ubit32 nLen, int bCopy = TRUE);
@@ -52,6 +98,7 @@ public:
     void PressReturn(const char *cmd);
     void PlayLoop(const char *cmd);
     void MudDown(const char *cmd);
+    void Resume(const char *cmd);
     void MenuSelect(const char *cmd);
     void SequenceCompare(ubit8 *pBuf, int *pnLen);
     void SetWebsocket(wsserver *server, websocketpp::connection_hdl hdl);
@@ -84,8 +131,12 @@ public:
     char m_aHost[50];
     void (*m_pFptr)(cConHook *, const char *cmd);
 
+    std::string m_sSession; ///< Given by the server at login, to resume after a restart
+    ubit32 m_nCookie;       ///< Tells the connections apart in resume requests
+
     wsserver *m_pWebsServer;
     websocketpp::connection_hdl m_pWebsHdl;
+    ws_stats m_sWsStats; ///< Output sent on the websocket
 
     cConHook *m_pNext;
 
@@ -99,12 +150,13 @@ private:
     std::mutex m_mtx; ///< Mutex for websockets threading
 };
 
-std::string mplex_getcolor(cConHook *hook, const char *colorstr);
+const std::string &mplex_getcolor(cConHook *hook, const char *colorstr);
 
 void dumbPlayLoop(cConHook *con, const char *cmd);
 void dumbPressReturn(cConHook *con, const char *cmd);
 void dumbMenuSelect(cConHook *con, const char *cmd);
 void dumbMudDown(cConHook *con, const char *cmd);
+void dumbResume(cConHook *con, const char *cmd);
 void Idle(cConHook *con, const char *cmd);
 
 void ClearUnhooked();
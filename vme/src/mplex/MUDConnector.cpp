@@ -32,6 +32,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
 #include <thread>
 
 namespace mplex
@@ -41,6 +42,7 @@ namespace mplex
 using ::protocol_send_mplex_info;
 using ::protocol_send_host;
 using ::protocol_send_close;
+using ::protocol_send_resume;
 using ::protocol_parse_incoming;
 using ::cQueueElem;
 using ::cHook;
@@ -118,6 +120,16 @@ void test_mud_up()
     for (con = g_connection_list; con; con = nextcon)
     {
         nextcon = con->m_pNext;
+
+        // Players who were in the game are put back by resume_sessions()
+        if (!con->m_sSession.empty())
+        {
+            con->m_pFptr = dumbResume;
+            con->m_nState = 0;
+            con->m_qInput.Flush();
+            continue;
+        }
+
         auto buf = diku::format_to_str("%s has begun rebooting... please wait.<br/>", g_mudname);
         con->SendCon(buf);
 
@@ -140,9 +152,20 @@ void mud_went_down()
 
     for (con = g_connection_list; con; con = con->m_pNext)
     {
-        auto buf = diku::format_to_str("The connection to %s was broken. "
-                                       "Please be patient...<br/>",
-                                       g_mudname);
+        std::string buf;
+
+        if (con->m_sSession.empty())
+        {
+            buf = diku::format_to_str("The connection to %s was broken. "
+                                      "Please be patient...<br/>",
+                                      g_mudname);
+        }
+        else
+        {
+            buf = diku::format_to_str("%s is restarting. Stay connected and you will be "
+                                      "put back into the game when it is up.<br/>",
+                                      g_mudname);
+        }
         con->SendCon(buf);
         con->m_nId = 0;
         con->m_pFptr = dumbMudDown;
@@ -150,6 +173,52 @@ void mud_went_down()
     }
 }
 
+// Put the players who were in the game before a restart back in, no more
+// than nResumeRate a second so the server isn't swamped with player loads
+// the moment it is up. Returns true if some are still waiting their turn.
+bool resume_sessions()
+{
+    static time_t nSecond = 0;
+    static int nSent = 0;
+    cConHook *con = nullptr;
+
+    if (!g_MudHook.IsHooked())
+    {
+        return false;
+    }
+
+    if (time(nullptr) != nSecond)
+    {
+        nSecond = time(nullptr);
+        nSent = 0;
+    }
+
+    for (con = g_connection_list; con; con = con->m_pNext)
+    {
+        if (con->m_pFptr != dumbResume || con->m_nState != 0)
+        {
+            continue;
+        }
+
+        if (nSent >= g_mplex_arg.nResumeRate)
+        {
+            return true;
+        }
+
+        auto buf = diku::format_to_str("%u %d %d %s %s",
+                                       con->m_nCookie,
+                                       g_mplex_arg.nMotherPort,
+                                       con->m_nLine,
+                                       *con->m_aHost ? con->m_aHost : "UNKNOWN",
+                                       con->m_sSession.c_str());
+        protocol_send_resume(&g_MudHook, 0, buf.c_str());
+        con->m_nState = 1; // Waiting for the new ID
+        nSent++;
+    }
+
+    return false;
+}
+
 // Main MPLEX loop called by main() in mplex.cpp
 void Control()
 {
@@ -198,7 +267,9 @@ void Control()
         // not a problem because somebody will either trigger an existing connection
         // or telnet to get a new connection. Then Wait() will finish and a new
         // round begins.
-        n = g_CaptainHook.Wait(nullptr);
+        // Wake up again in a bit if some are still waiting to be resumed
+        timeval tv = {0, 250000};
+        n = g_CaptainHook.Wait(resume_sessions() ? &tv : nullptr);
 
         if (n == -1)
         {
@@ -233,18 +304,22 @@ void cMotherHook::Input(int nFlags)
     }
     else if (nFlags & SELECT_READ)
     {
-        cConHook *con = new cConHook();
+        // Take everyone waiting, after a restart they all come at once
+        AcceptAll(tfd(), g_Admission, [](int fd, const sockaddr_in &addr) {
+            cConHook *con = new cConHook();
+            con->Accept(fd, inet_ntoa(addr.sin_addr));
 
-        if (g_nConnectionsLeft <= 1)
-        {
-            slog(LOG_OFF, 0, "Can't accept more connections.");
-            con->SendCon("This server has no more available connections, try "
-                         "another port.<br/>");
-        }
-        else
-        {
-            con->m_pFptr(con, "");
-        }
+            if (g_nConnectionsLeft <= 1)
+            {
+                slog(LOG_OFF, 0, "Can't accept more connections.");
+                con->SendCon("This server has no more available connections, try "
+                             "another port.<br/>");
+            }
+            else
+            {
+                con->m_pFptr(con, "");
+            }
+        });
     }
 }
 
@@ -394,6 +469,38 @@ int cMudHook::read_mud()
             }
             return 1;
 
+        case MULTI_SESSION_CHAR:
+            for (con = g_connection_list; con; con = con->m_pNext)
+            {
+                if (con->m_nId == id)
+                {
+                    con->m_sSession = data;
+                    break;
+                }
+            }
+            break;
+
+        case MULTI_RESUME_CHAR:
+            for (con = g_connection_list; con; con = con->m_pNext)
+            {
+                if (con->m_nId == 0 && con->m_pFptr == dumbResume && con->m_nState == 1 && con->m_nCookie == strtoul(data, nullptr, 10))
+                {
+                    slog(LOG_OFF, 0, "MULTI_RESUME_CHAR: Resumed session as id %d", id);
+                    con->m_nId = id;
+                    con->m_nState = 0;
+                    con->m_pFptr = dumbPlayLoop;
+                    // The server sends a new one if the session was good
+                    con->m_sSession.clear();
+                    break;
+                }
+            }
+            if (con == nullptr)
+            {
+                slog(LOG_OFF, 0, "Unknown destination for resume! Requesting term.");
+                protocol_send_close(&g_MudHook, id);
+            }
+            break;
+
         case MULTI_CONNECT_CON_CHAR:
             // slog(LOG_OFF,0,"MULTI_CON_CHAR: Received id=%d", id);
             if (data)
@@ -37,6 +37,7 @@ public:
 void Control();
 void test_mud_up();
 void mud_went_down();
+bool resume_sessions();
 
 // I think this is the open socket from the main listening telnet port
 extern cMotherHook g_MotherHook;
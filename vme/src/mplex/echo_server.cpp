@@ -21,6 +21,8 @@ using ::str_correct_utf8;
 // pull out the type of messages sent by our config
 typedef wsserver::message_ptr message_ptr;
 
+thread_local ws_stats *g_ws_sending = nullptr;
+
 // std::map<std::owner_less<websocketpp::connection_hdl>, void *> g_cMapHandler;
 std::map<websocketpp::connection_hdl, cConHook *, std::owner_less<websocketpp::connection_hdl>> g_cMapHandler;
 
@@ -59,7 +61,7 @@ void on_close(websocketpp::connection_hdl hdl)
 }
 
 // send message back to websocket client: 1 is message sent, 0 if failure
-int ws_send_message(wsserver *s, websocketpp::connection_hdl hdl, const char *txt)
+int ws_send_message(wsserver *s, websocketpp::connection_hdl hdl, const char *txt, ws_stats *stats)
 {
     std::string mystr(txt);
 
@@ -67,12 +69,28 @@ int ws_send_message(wsserver *s, websocketpp::connection_hdl hdl, const char *tx
 
     try
     {
-        s->send(hdl, mystr.c_str(), mystr.length(), websocketpp::frame::opcode::text);
-        // s->send(hdl, txt, strlen(txt), websocketpp::frame::opcode::text);
+        // Messages are only compressed when marked so, send(hdl, ptr, len, op) does not.
+        // The frame is compressed inside send() if the client negotiated permessage-deflate.
+        auto con = s->get_con_from_hdl(hdl);
+        auto msg = con->get_message(websocketpp::frame::opcode::text, mystr.length());
+        msg->append_payload(mystr);
+        msg->set_compressed(true);
+
+        g_ws_sending = stats;
+        websocketpp::lib::error_code ec = con->send(msg);
+        g_ws_sending = nullptr;
+        if (ec)
+        {
+            throw websocketpp::exception(ec);
+        }
+
+        stats->messages++;
+        stats->bytes += mystr.length();
         return 1;
     }
     catch (websocketpp::exception const &e)
     {
+        g_ws_sending = nullptr;
         slog(LOG_OFF, 0, "Send failed: %s", e.what());
         return 0;
     }
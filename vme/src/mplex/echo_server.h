@@ -7,6 +7,6 @@ namespace mplex
 
 void runechoserver();
 void remove_gmap(cConHook *con);
-int ws_send_message(wsserver *s, websocketpp::connection_hdl hdl, const char *txt);
+int ws_send_message(wsserver *s, websocketpp::connection_hdl hdl, const char *txt, ws_stats *stats);
 
 } // namespace mplex
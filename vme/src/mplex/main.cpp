@@ -80,7 +80,8 @@ int main(int argc, char *argv[])
     }
     else
     {
-        fd = mplex::OpenMother(mplex::g_mplex_arg.nMotherPort);
+        fd = mplex::OpenMother(mplex::g_mplex_arg.nMotherPort, mplex::g_mplex_arg.nMotherBacklog);
+        mplex::g_Admission.SetRate(mplex::g_mplex_arg.nAcceptRate, mplex::g_mplex_arg.nAcceptRate);
         Assert(fd != -1, "NO MOTHER CONNECTION.");
 
         if (mplex::g_MotherHook.tfd() != -1)
@@ -64,13 +64,17 @@ void alarm_signal(int sig)
 void ShowUsage(const char *name)
 {
     fprintf(stderr,
-            "Usage: %s [-a] [-h] [-c] [-e] [-r] [-t] [-x] [-l <filename>] [-p <num>] [-d <path>] [-s <port>] [-a <address>]\n",
+            "Usage: %s [-a] [-h] [-c] [-e] [-r] [-t] [-x] [-l <filename>] [-p <num>] [-b <num>] [-i <num>] [-u <num>] [-d <path>] [-s <port>] [-a "
+            "<address>]\n",
             name);
     fprintf(stderr, "  -h  This help screen.\n");
     fprintf(stderr, "  -c  Deprecated. Always on. ANSI Colour when set, TTY when not.\n");
     fprintf(stderr, "  -e  Echo mode (echo chars locally).\n");
     fprintf(stderr, "  -r  Redraw prompt lcoally (usually only in -e mode).\n");
     fprintf(stderr, "  -p  Player port number, default is 4242.\n");
+    fprintf(stderr, "  -b  Listen backlog of the player port (default %d).\n", SOMAXCONN);
+    fprintf(stderr, "  -i  New connections per minute from one address, 0 for no limit (default 30).\n");
+    fprintf(stderr, "  -u  Players put back into the game per second after a restart (default 20).\n");
     fprintf(stderr, "  -a  Internet address of server (localhost default).\n");
     fprintf(stderr, "  -s  Internet port of server (4999 default).\n");
     fprintf(stderr, "  -l  Name of the logfile (default: ./mplex.log).\n");
@@ -94,6 +98,9 @@ int ParseArg(int argc, char *argv[], arg_type *arg)
 
     arg->nMudPort = 4999;    /* Default port */
     arg->nMotherPort = 4242; /* Default port */
+    arg->nMotherBacklog = SOMAXCONN;
+    arg->nAcceptRate = 30;
+    arg->nResumeRate = 20;
     arg->pAddress = str_dup(DEF_SERVER_ADDR);
     arg->g_bUseTLS = false;
 
@@ -190,6 +197,27 @@ int ParseArg(int argc, char *argv[], arg_type *arg)
                 arg->nMotherPort = n;
                 break;
 
+            case 'b':
+                i++;
+                n = atoi(argv[i]);
+                Assert(n > 0, "Backlog must be positive.");
+                arg->nMotherBacklog = n;
+                break;
+
+            case 'i':
+                i++;
+                n = atoi(argv[i]);
+                Assert(n >= 0, "Accept rate can't be negative.");
+                arg->nAcceptRate = n;
+                break;
+
+            case 'u':
+                i++;
+                n = atoi(argv[i]);
+                Assert(n > 0, "Resume rate must be positive.");
+                arg->nResumeRate = n;
+                break;
+
             case 's':
                 i++;
                 n = atoi(argv[i]);
@@ -21,6 +21,9 @@ namespace mplex
 struct arg_type
 {
     int nMotherPort;
+    int nMotherBacklog; // listen() backlog of the mother connection
+    int nAcceptRate;    // Connections per minute from one address, 0 for no limit
+    int nResumeRate;    // Sessions resumed per second after the MUD restarted
     int nMudPort;
     char *pAddress;
     int g_bModeANSI;
@@ -20,13 +20,134 @@
 #include <sys/un.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdlib>
 
 namespace mplex
 {
 
-int OpenMother(int nPort)
+#define ADMISSION_PRUNE 10000 // Forget full buckets when more addresses than this are known
+
+cAdmission g_Admission;
+
+cAdmission::cAdmission()
+{
+    m_nPerMinute = 0;
+    m_nCapacity = 0;
+    m_nPruneAt = ADMISSION_PRUNE;
+}
+
+void cAdmission::SetRate(int nPerMinute, int nBurst)
+{
+    m_nPerMinute = nPerMinute;
+    m_nCapacity = (ubit32)std::max(nBurst, 1) * 60;
+    m_nPruneAt = ADMISSION_PRUNE;
+    m_aBuckets.clear();
+}
+
+// nAddr is in network byte order, as in sockaddr_in
+bool cAdmission::Admit(ubit32 nAddr, time_t nNow)
+{
+    if (m_nPerMinute <= 0 || (ntohl(nAddr) >> 24) == 127)
+    {
+        return true;
+    }
+
+    if (m_aBuckets.size() > m_nPruneAt)
+    {
+        // A bucket that has filled up again is the same as no bucket
+        for (auto it = m_aBuckets.begin(); it != m_aBuckets.end();)
+        {
+            if ((ubit64)(nNow - it->second.nLast) * m_nPerMinute + it->second.nCredit >= m_nCapacity)
+            {
+                it = m_aBuckets.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        // Don't sweep again on every connection while under attack from many addresses
+        m_nPruneAt = std::max<size_t>(ADMISSION_PRUNE, 2 * m_aBuckets.size());
+    }
+
+    auto it = m_aBuckets.find(nAddr);
+    if (it == m_aBuckets.end())
+    {
+        it = m_aBuckets.insert({nAddr, {nNow, m_nCapacity}}).first;
+    }
+
+    bucket &b = it->second;
+    if (nNow > b.nLast)
+    {
+        b.nCredit = (ubit32)std::min<ubit64>(m_nCapacity, b.nCredit + (ubit64)(nNow - b.nLast) * m_nPerMinute);
+        b.nLast = nNow;
+    }
+
+    if (b.nCredit < 60)
+    {
+        return false;
+    }
+
+    b.nCredit -= 60;
+    return true;
+}
+
+/**
+ * Accept every connection waiting on the mother socket, not just one per
+ * select(). After a game restart all the clients reconnect at once and the
+ * backlog would otherwise fill up and drop them. Connections refused by
+ * admission are closed before anything is allocated for them.
+ * Returns the number of connections handed to fAccepted.
+ */
+int AcceptAll(int fdMother, cAdmission &admission, const std::function<void(int fd, const sockaddr_in &addr)> &fAccepted)
+{
+    int nAccepted = 0;
+
+    for (;;)
+    {
+        sockaddr_in conaddr;
+#ifdef _WINDOWS
+        int size = sizeof(conaddr);
+#else
+        socklen_t size = sizeof(conaddr);
+#endif
+        int fd = accept(fdMother, (sockaddr *)&conaddr, &size);
+
+        if (fd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                slog(LOG_OFF, 0, "accept() on mother connection failed (errno %d).", errno);
+            }
+            break;
+        }
+
+        if (!admission.Admit(conaddr.sin_addr.s_addr, time(nullptr)))
+        {
+            slog(LOG_ALL, 0, "Refused connection from %s, too many attempts.", inet_ntoa(conaddr.sin_addr));
+#ifdef _WINDOWS
+            closesocket(fd);
+#else
+            close(fd);
+#endif
+            continue;
+        }
+
+        fAccepted(fd, conaddr);
+        nAccepted++;
+    }
+
+    return nAccepted;
+}
+
+int OpenMother(int nPort, int nBacklog)
 {
     int n = 0;
     int fdMother = 0;
@@ -115,7 +236,7 @@ int OpenMother(int nPort)
         exit(1);
     }
 
-    n = listen(fdMother, 5);
+    n = listen(fdMother, nBacklog);
 
     if (n != 0)
     {
@@ -10,6 +10,8 @@
     #include <winsock.h>
 #endif
 
+#include "essential.h"
+
 #include <sys/types.h>
 
 #ifdef LINUX
@@ -18,12 +20,48 @@
     #include <sys/socket.h>
 #endif
 
+#include <ctime>
+#include <functional>
+#include <unordered_map>
+
 #define DEF_SERVER_ADDR "127.0.0.1"
 
 namespace mplex
 {
 
-int OpenMother(int port);
+/**
+ * Limits how fast new connections are taken from each remote address, so a
+ * single host can't eat all the descriptors by reconnecting in a loop. Each
+ * address has a token bucket holding up to nBurst connections which refills
+ * at nPerMinute. Loopback is never limited, it is where the web client
+ * proxies and the test clients connect from.
+ */
+class cAdmission
+{
+public:
+    cAdmission();
+
+    void SetRate(int nPerMinute, int nBurst);
+    bool Admit(ubit32 nAddr, time_t nNow);
+    int Count() const { return (int)m_aBuckets.size(); }
+
+private:
+    struct bucket
+    {
+        time_t nLast;   // Last time the credit was brought up to date
+        ubit32 nCredit; // In 1/60 of a connection
+    };
+
+    int m_nPerMinute;
+    ubit32 m_nCapacity;
+    size_t m_nPruneAt;
+    std::unordered_map<ubit32, bucket> m_aBuckets;
+};
+
+int OpenMother(int nPort, int nBacklog);
 int OpenNetwork(int nMudPort, char *pMudAddr);
+int AcceptAll(int fdMother, cAdmission &admission, const std::function<void(int fd, const sockaddr_in &addr)> &fAccepted);
+
+extern cAdmission g_Admission;
 
 } // namespace mplex
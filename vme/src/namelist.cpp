@@ -104,15 +104,25 @@ int cNamelist::ReadBuffer(CByteBuffer *pBuf, int unit_version)
 
         len = pBuf->ReadU32(&corrupt);
 
-        if (corrupt)
+        // Every name takes at least its NUL, so a larger count is corrupt
+        if (corrupt || len > pBuf->GetLength() - pBuf->GetReadPosition())
         {
             return 1;
         }
 
+        // Size the list once and build the names straight from the buffer
+        if (len > 0)
+        {
+            RECREATE(namelist, std::string *, length + len);
+        }
+
         for (i = 0; i < len; i++)
         {
-            pBuf->SkipString(&c);
-            AppendName(c);
+            if (pBuf->SkipString(&c))
+            {
+                return 1;
+            }
+            namelist[length++] = new std::string(c);
         }
         return 0;
     }
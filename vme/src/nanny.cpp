@@ -23,6 +23,7 @@
 #include "db.h"
 #include "dilinst.h"
 #include "dilrun.h"
+#include "dilstring.h"
 #include "files.h"
 #include "formatter.h"
 #include "handler.h"
@@ -30,6 +31,7 @@
 #include "main_functions.h"
 #include "nanny.h"
 #include "pcsave.h"
+#include "protocol.h"
 #include "reception.h"
 #include "skills.h"
 #include "slog.h"
@@ -39,10 +41,14 @@
 #include "vmelimits.h"
 
 #include <arpa/inet.h>
+#include <sys/stat.h>
 
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
 
 int g_dilmenu;
 
@@ -385,7 +391,7 @@ void nanny_dil(descriptor_data *d, char *arg)
     {
         prg->waitcmd = WAITCMD_MAXINST - 1; // The usual hack, see db_file
 
-        prg->fp->vars[0].val.string = str_dup(arg);
+        prg->fp->vars[0].val.string = dilstr_new(arg);
 
         dil_activate(prg);
     }
@@ -397,6 +403,94 @@ void nanny_dil(descriptor_data *d, char *arg)
     }
 }
 
+/* ---------------------------------------------------------------------
+ * Sessions let the mplex'er put players back into the game after a
+ * restart without asking for the password again. A session is the
+ * player name and a hash keyed with a secret kept in the lib directory,
+ * so it is still good after the restart and stops working when the
+ * password is changed.
+ * --------------------------------------------------------------------- */
+
+static const std::string &session_secret()
+{
+    static std::string secret;
+
+    if (secret.empty())
+    {
+        auto name = g_cServerConfig.getFileInLibDir(SESSION_KEY_FILE);
+        char buf[128] = "";
+
+        FILE *f = fopen(name.c_str(), "r");
+        if (f)
+        {
+            if (fgets(buf, sizeof(buf), f) == nullptr)
+            {
+                *buf = '\0';
+            }
+            fclose(f);
+            strip_trailing_spaces(buf);
+            secret = buf;
+        }
+
+        if (secret.length() < 32)
+        {
+            std::random_device rd;
+
+            secret.clear();
+            for (int i = 0; i < 8; i++)
+            {
+                snprintf(buf, sizeof(buf), "%08x", rd());
+                secret += buf;
+            }
+
+            f = fopen(name.c_str(), "w");
+            if (f)
+            {
+                fprintf(f, "%s\n", secret.c_str());
+                fclose(f);
+                chmod(name.c_str(), 0600);
+            }
+            else
+            {
+                slog(LOG_ALL, 0, "Unable to save %s, sessions will not survive a restart.", name.c_str());
+            }
+        }
+    }
+
+    return secret;
+}
+
+/* Empty if this platform's crypt() can't do SHA-512 */
+static std::string session_hash(unit_data *pc)
+{
+    std::string key = session_secret() + ":" + PC_FILENAME(pc) + ":" + PC_PWD(pc);
+    const char *hash = crypt(key.c_str(), "$6$session$");
+
+    if (hash == nullptr || strncmp(hash, "$6$", 3) != 0)
+    {
+        return "";
+    }
+
+    return strrchr(hash, '$') + 1;
+}
+
+/* Give the mplex'er the session of a player who just logged in */
+static void session_send(descriptor_data *d)
+{
+    if (PC_IS_UNSAVED(d->getCharacter()))
+    {
+        return;
+    }
+
+    std::string hash = session_hash(d->getCharacter());
+
+    if (!hash.empty())
+    {
+        std::string session = std::string(PC_FILENAME(d->getCharacter())) + " " + hash;
+        protocol_send_session(d->getMultiHookPtr(), d->getMultiHookID(), session.c_str());
+    }
+}
+
 void nanny_pwd_confirm(descriptor_data *d, char *arg)
 {
     unit_data *u = nullptr;
@@ -428,6 +522,7 @@ void nanny_pwd_confirm(descriptor_data *d, char *arg)
     }
 
     assign_player_file_index(d->getCharacter());
+    session_send(d);
 
     /* See if guest is in game, if so - a guest was LD       */
     /* Password has now been redefined                       */
@@ -631,11 +726,57 @@ void nanny_menu(descriptor_data *d, char *arg)
     nanny_close(d, arg);
 }
 
-void nanny_existing_pwd(descriptor_data *d, char *arg)
+/* The password is ok (or the session was), let the player in */
+static void nanny_logged_in(descriptor_data *d)
 {
     descriptor_data *td = nullptr;
     unit_data *u = nullptr;
 
+    session_send(d);
+
+    const auto last_connect = PC_TIME(d->getCharacter()).getPlayerLastConnectTime();
+    auto msg2 = diku::format_to_str("<br/>Welcome back %s, you last visited %s on %s<br/>",
+                                    d->cgetCharacter()->getNames().Name(),
+                                    g_cServerConfig.getMudName().c_str(),
+                                    ctime(&last_connect));
+    send_to_descriptor(msg2, d);
+
+    if ((td = find_descriptor(PC_FILENAME(d->getCharacter()), d)))
+    {
+        set_descriptor_fptr(d, nanny_throw, TRUE);
+        return;
+    }
+
+    /* See if player is in game (guests are not created in file entries) */
+    /* Enters game (reconnects) if true                                  */
+    for (u = g_unit_list; u; u = u->getGlobalNext())
+    {
+        if (!u->isPC())
+        {
+            break;
+        }
+
+        if (str_ccmp(PC_FILENAME(u), PC_FILENAME(d->getCharacter())) == 0)
+        {
+            //	  assert (!CHAR_DESCRIPTOR (u));
+            //	  assert (UNIT_IN (u));
+
+            UPC(u)->reconnect_game(d);
+            return;
+        }
+    }
+
+    /* Ok, he wasn't Link Dead, lets enter the game via menu */
+    slog(LOG_BRIEF, CHAR_LEVEL(d->cgetCharacter()), "%s[%s] has connected.", PC_FILENAME(d->getCharacter()), d->getHostname());
+
+    send_to_descriptor("<br/>", d);
+    set_descriptor_fptr(d, nanny_motd, TRUE);
+}
+
+void nanny_existing_pwd(descriptor_data *d, char *arg)
+{
+    descriptor_data *td = nullptr;
+
     /* PC_ID(d->character) can be -1 when a newbie is in the game and
         someone logins with the same name! */
 
@@ -714,43 +855,58 @@ void nanny_existing_pwd(descriptor_data *d, char *arg)
 
     UPC(d->getCharacter())->setNumberOfCrackAttempts(0);
 
-    const auto last_connect = PC_TIME(d->getCharacter()).getPlayerLastConnectTime();
-    auto msg2 = diku::format_to_str("<br/>Welcome back %s, you last visited %s on %s<br/>",
-                                    d->cgetCharacter()->getNames().Name(),
-                                    g_cServerConfig.getMudName().c_str(),
-                                    ctime(&last_connect));
-    send_to_descriptor(msg2, d);
+    nanny_logged_in(d);
+}
 
-    if ((td = find_descriptor(PC_FILENAME(d->getCharacter()), d)))
+/*
+ * The mplex'er kept the connection open while the game restarted and
+ * hands back the session the player got at login. Returns FALSE if the
+ * session is no good, the player then logs in the normal way.
+ */
+int nanny_resume(descriptor_data *d, const char *name, const char *hash)
+{
+    char tmp_name[100];
+    unit_data *ch = nullptr;
+
+    if (_parse_name(name, tmp_name) || !player_exists(tmp_name))
     {
-        set_descriptor_fptr(d, nanny_throw, TRUE);
-        return;
+        return FALSE;
     }
 
-    /* See if player is in game (guests are not created in file entries) */
-    /* Enters game (reconnects) if true                                  */
-    for (u = g_unit_list; u; u = u->getGlobalNext())
+    if (site_banned(d->getHostname()) == BAN_TOTAL)
     {
-        if (!u->isPC())
-        {
-            break;
-        }
+        return FALSE;
+    }
 
-        if (str_ccmp(PC_FILENAME(u), PC_FILENAME(d->getCharacter())) == 0)
-        {
-            //	  assert (!CHAR_DESCRIPTOR (u));
-            //	  assert (UNIT_IN (u));
+    ch = load_player(tmp_name);
 
-            UPC(u)->reconnect_game(d);
-            return;
-        }
+    if (ch == nullptr)
+    {
+        return FALSE;
     }
 
-    /* Ok, he wasn't Link Dead, lets enter the game via menu */
-    slog(LOG_BRIEF, CHAR_LEVEL(d->cgetCharacter()), "%s[%s] has connected.", PC_FILENAME(d->getCharacter()), d->getHostname());
+    std::string expected = session_hash(ch);
 
-    send_to_descriptor("<br/>", d);
-    set_descriptor_fptr(d, nanny_motd, TRUE);
+    if (expected.empty() || hashcompare(expected.c_str(), hash) || (g_wizlock && CHAR_LEVEL(ch) < g_wizlock))
+    {
+        slog(LOG_ALL, 0, "Session for %s[%s] not resumed.", tmp_name, d->getHostname());
+        extract_unit(ch);
+        return FALSE;
+    }
+
+    UCHAR(d->cgetCharacter())->setDescriptor(nullptr);
+    extract_unit(d->getCharacter());
+
+    UCHAR(ch)->setDescriptor(d);
+    d->setCharacter(ch);
+
+    UPC(d->getCharacter())->getTerminalSetupType().colour_convert = 0;
+    MplexSendSetup(d);
+
+    slog(LOG_BRIEF, CHAR_LEVEL(d->cgetCharacter()), "%s[%s] resumed the session.", PC_FILENAME(d->getCharacter()), d->getHostname());
+    nanny_logged_in(d);
+
+    return TRUE;
 }
 
 void nanny_name_confirm(descriptor_data *d, char *arg)
@@ -9,6 +9,7 @@ void nanny_close(descriptor_data *d, char *arg);
 void nanny_get_name(descriptor_data *d, char *arg);
 void nanny_menu(descriptor_data *d, char *arg);
 void nanny_new_pwd(descriptor_data *d, char *arg);
+int nanny_resume(descriptor_data *d, const char *name, const char *hash);
 void reset_char(unit_data *ch);
 void set_descriptor_fptr(descriptor_data *d, void (*fptr)(descriptor_data *, char *), ubit1 call);
 void interpreter_string_add(descriptor_data *d, char *str);
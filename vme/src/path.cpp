@@ -104,6 +104,59 @@ void cleanup_sc_dijkstra(void *t)
     slog(LOG_ALL, 0, "Shutting Down Shortest Path VME thread");
 }
 
+/* Run Dijkstra from src and keep only the direction of the first step  */
+/* towards each room of the component, which is all move_to() needs.    */
+std::vector<ubit8> create_first_hops(const graph_t &g, int src)
+{
+    typedef boost::graph_traits<graph_t>::vertex_descriptor vertex_descriptor;
+    typedef boost::graph_traits<graph_t>::edge_descriptor edge_descriptor;
+    const ubit8 unresolved = 0xFF;
+    size_t n = num_vertices(g);
+    std::vector<vertex_descriptor> pred(n);
+    std::vector<int> dist(n);
+    std::vector<ubit8> hop(n, unresolved);
+    std::vector<vertex_descriptor> chain;
+    edge_descriptor ed;
+    bool success = 0;
+
+    dijkstra_shortest_paths(g, src, boost::predecessor_map(&pred[0]).distance_map(&dist[0]));
+
+    auto dir = get(boost::edge_dir, g);
+    hop[src] = DIR_HERE;
+
+    for (vertex_descriptor v = 0; v < n; v++)
+    {
+        vertex_descriptor w = v;
+
+        /* Walk towards src until we meet a room that is already resolved */
+        while (hop[w] == unresolved)
+        {
+            if (pred[w] == w)
+            {
+                hop[w] = DIR_IMPOSSIBLE;
+            }
+            else if ((int)pred[w] == src)
+            {
+                tie(ed, success) = edge(src, w, g);
+                hop[w] = success ? dir[ed] : DIR_IMPOSSIBLE;
+            }
+            else
+            {
+                chain.push_back(w);
+                w = pred[w];
+            }
+        }
+
+        for (auto c : chain)
+        {
+            hop[c] = hop[w];
+        }
+        chain.clear();
+    }
+
+    return hop;
+}
+
 void *create_sc_dijkstra(void *thread)
 {
     //	typedef graph_traits < graph_t >::vertex_descriptor vertex_descriptor;
@@ -123,13 +176,10 @@ void *create_sc_dijkstra(void *thread)
             //					slog (LOG_ALL, 0, "Creating Dijkstra for room %s@%s",
             //								UNIT_FI_NAME (u), UNIT_FI_ZONENAME (u));
 
-            ROOM_PATH(u).resize(num_vertices(g_sc_graphs[ROOM_SC(u)]));
-            ROOM_DISTANCE(u).resize(num_vertices(g_sc_graphs[ROOM_SC(u)]));
+            auto hops = create_first_hops(g_sc_graphs[ROOM_SC(u)], ROOM_NUM(u));
 
-            dijkstra_shortest_paths(g_sc_graphs[ROOM_SC(u)],
-                                    ROOM_NUM(u),
-                                    boost::predecessor_map(&ROOM_PATH(u)[0]).distance_map(&ROOM_DISTANCE(u)[0]));
             pthread_mutex_lock(&dijkstra_queue_mutex);
+            ROOM_PATH(u) = std::move(hops);
             UROOM(u)->setWaitingDijkstra(false);
             pthread_mutex_unlock(&dijkstra_queue_mutex);
         }
@@ -261,12 +311,6 @@ int path_weight(unit_data *from, unit_data *to, int dir)
 /* Primitive move generator, returns direction */
 int move_to(unit_data *from, unit_data *to)
 {
-    typedef boost::graph_traits<graph_t>::edge_descriptor edge_descriptor;
-    edge_descriptor ed;
-    bool success = 0;
-    int i = 0;
-    int next = 0;
-
     if (!from)
     {
         return DIR_IMPOSSIBLE;
@@ -304,40 +348,5 @@ int move_to(unit_data *from, unit_data *to)
         return DIR_TRYAGAIN;
     }
 
-    i = ROOM_NUM(to);
-    next = i; // MS2020 Next could be uninitialized. I'm not sure if it should be zero or i? Or if more bugs are hiding here.
-    while (i != ROOM_NUM(from))
-    {
-        next = i;
-        i = ROOM_PATH(from)[i];
-    }
-
-    boost::property_map<graph_t, boost::edge_dir_t>::type dir = get(boost::edge_dir, g_sc_graphs[ROOM_SC(from)]);
-    tie(ed, success) = edge(ROOM_NUM(from), next, g_sc_graphs[ROOM_SC(from)]);
-    if (success)
-    {
-        return (dir[ed]);
-    }
-    else
-    {
-        return (DIR_IMPOSSIBLE);
-    }
-    /*	for (i = 0; i <= MAX_EXIT; i++)
-                if (ROOM_EXIT(from,i) && ROOM_EXIT(from,i)->to_room && ROOM_NUM (ROOM_EXIT (from, i)->to_room) == next)
-                        return i;
-
-
-        for (uu = UNIT_CONTAINS (from); uu; uu = uu->next)
-                if (IS_ROOM (uu)
-                                && IS_SET (UNIT_MANIPULATE (uu), MANIPULATE_ENTER)
-                                && ROOM_NUM (uu) == next)
-                        return DIR_ENTER;
-
-        if (UNIT_IN (from) && IS_ROOM (UNIT_IN (from)))
-                if (IS_SET (UNIT_MANIPULATE (UNIT_IN (from)), MANIPULATE_ENTER)
-                                && ROOM_NUM (UNIT_IN (from)) == next)
-                        return DIR_EXIT;
-
-        return DIR_IMPOSSIBLE;
-        */
+    return ROOM_PATH(from)[ROOM_NUM(to)];
 }
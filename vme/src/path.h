@@ -24,6 +24,7 @@ using graph_t = boost::adjacency_list<boost::vecS,
 int move_to(unit_data *from, unit_data *to);
 int path_weight(unit_data *from, unit_data *to, int dir);
 void create_sc_graph(int num_of_sc);
+std::vector<ubit8> create_first_hops(const graph_t &g, int src);
 void *create_sc_dijkstra(void *thread);
 void create_worldgraph();
 
@@ -26,10 +26,97 @@
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
 
 // MS2020 sbit32 g_player_id = -1;
 sbit32 g_player_id = 1; // Looks to me like it needs to begin with 1 (crash on start)
 
+/* Player id of every player file by lower case name. Built by
+   player_file_index() at boot and kept up to date when players are
+   saved and deleted, so lookups never go to the disk. Until it has
+   been built (e.g. in tools without a game boot) we ask the disk. */
+static std::unordered_map<std::string, sbit32> g_player_index;
+static bool g_player_index_loaded = false;
+
+static std::string player_index_key(const char *pName)
+{
+    std::string key;
+
+    if (pName)
+    {
+        key = pName;
+        str_lower(key);
+    }
+    return key;
+}
+
+/* Read the id from the head of a player file, -1 on failure */
+static sbit32 read_player_file_id(const char *pFileName)
+{
+    FILE *pFile = nullptr;
+    sbit32 id = -1;
+
+    pFile = fopen(pFileName, "rb");
+
+    if (pFile == nullptr)
+    {
+        return -1;
+    }
+
+    if (fread(&id, sizeof(sbit32), 1, pFile) != 1)
+    {
+        id = -1;
+    }
+
+    fclose(pFile);
+
+    return id;
+}
+
+/* Players are saved as <plydir>/<first letter>/<name>, anything with a
+   dot in it (inventories, temporary files) is not a player. Without a
+   configured plydir the names are relative to the working directory. */
+static void index_player_files()
+{
+    std::filesystem::path plydir{g_cServerConfig.getPlyDir().empty() ? "." : g_cServerConfig.getPlyDir()};
+    std::error_code ec;
+
+    g_player_index.clear();
+
+    for (const auto &dir : std::filesystem::directory_iterator(plydir, ec))
+    {
+        if (!dir.is_directory(ec))
+        {
+            continue;
+        }
+
+        for (const auto &file : std::filesystem::directory_iterator(dir.path(), ec))
+        {
+            std::string name = file.path().filename().string();
+
+            if (!file.is_regular_file(ec) || name.find('.') != std::string::npos)
+            {
+                continue;
+            }
+
+            sbit32 id = read_player_file_id(file.path().c_str());
+
+            if (id == -1)
+            {
+                slog(LOG_ALL, 0, "Unable to read ID from player file %s.", file.path().c_str());
+                continue;
+            }
+
+            g_player_index[player_index_key(name.c_str())] = id;
+        }
+    }
+
+    g_player_index_loaded = true;
+    slog(LOG_ALL, 0, "Indexed %d player files.", (int)g_player_index.size());
+}
+
 void assign_player_file_index(unit_data *pc)
 {
     zone_type *z = find_zone(g_player_zone);
@@ -51,6 +138,11 @@ std::string PlayerFileName(const char *pName)
 /* Return TRUE if exists */
 int player_exists(const char *pName)
 {
+    if (g_player_index_loaded)
+    {
+        return g_player_index.count(player_index_key(pName)) > 0;
+    }
+
     return file_exists(PlayerFileName(pName));
 }
 
@@ -89,6 +181,8 @@ int delete_player(const char *pName)
         return FALSE;
     }
 
+    g_player_index.erase(player_index_key(pName));
+
     delete_inventory(pName);
 
     return TRUE;
@@ -106,6 +200,13 @@ sbit32 find_player_id(char *pName)
         return -1;
     }
 
+    if (g_player_index_loaded)
+    {
+        auto it = g_player_index.find(player_index_key(pName));
+
+        return it == g_player_index.end() ? -1 : it->second;
+    }
+
     pFile = fopen(PlayerFileName(pName).c_str(), "rb");
 
     if (pFile == nullptr)
@@ -206,6 +307,8 @@ void save_player_disk(const char *pName, char *pPassword, sbit32 id, int nPlyLen
 
     n = rename(tmp_player_name.c_str(), PlayerFileName(pName).c_str());
     assert(n == 0);
+
+    g_player_index[player_index_key(pName)] = id;
 }
 
 /* Save the player 'pc' (no inventory) */
@@ -535,6 +638,8 @@ void player_file_index()
         }
     }
 
+    index_player_files();
+
     if (!file_exists(g_cServerConfig.getFileInLibDir(PLAYER_ID_NAME)))
     {
         touch_file(g_cServerConfig.getFileInLibDir(PLAYER_ID_NAME));
@@ -4,6 +4,8 @@
 
 #include <string>
 
+class unit_data;
+
 std::string PlayerFileName(const char *);
 int delete_inventory(const char *pName);
 int delete_player(const char *);
@@ -16,6 +18,7 @@ void save_player_contents(unit_data *pc, int fast);
 sbit32 new_player_id();
 void assign_player_file_index(unit_data *pc);
 void save_player_file(unit_data *pc);
+void save_player_disk(const char *pName, char *pPassword, sbit32 id, int nPlyLen, const ubit8 *pPlyBuf);
 void player_file_index();
 
 extern sbit32 g_player_id;
@@ -3,6 +3,7 @@
 #include "dbfind.h"
 #include "dil.h"
 #include "dilrun.h"
+#include "dilstring.h"
 #include "essential.h"
 #include "hook.h"
 #include "slog.h"
@@ -236,7 +237,7 @@ void pipeMUD_dispatch(std::string str)
     {
         str_correct_utf8(str);
         prg->waitcmd = WAITCMD_MAXINST - 1; // The usual hack, see db_file
-        prg->fp->vars[0].val.string = str_dup(str.c_str());
+        prg->fp->vars[0].val.string = dilstr_new(str.c_str());
         dil_activate(prg);
     }
 }
@@ -50,6 +50,9 @@ void unsbind(char *sym);
  *	pp3.c
  */
 void cur_user();
+void depend_add(const char *file);
+void depend_reset();
+int depend_write(const char *depfile, const char *targets);
 void do_line(char at_bol);
 void doinclude(int izxx = 0, int izxy = 0, const char *izxz = 0);
 void doline(int izxx = 0, int izxy = 0, const char *izxz = 0);
@@ -43,6 +43,7 @@ int pp_main(const char *filename)
     }
     // MS2020 ifile	= FALSE;		/* No input file specified	*/
     // MS2020 ofile	= TRUE;		/* No output file specified	*/
+    depend_reset();          /* Dependencies are per input file */
     if (!inc_open(filename)) /* Open input file */
     {
         fatal("Unable to open input file");
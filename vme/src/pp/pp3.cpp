@@ -31,6 +31,9 @@
 /*	Functions contained in this module:				*/
 /*									*/
 /*		cur_user	Select current disk-user (CPM).		*/
+/*		depend_add	Remember a file read for the depfile.	*/
+/*		depend_reset	Forget all remembered files.		*/
+/*		depend_write	Write a Make style depfile.		*/
 /*		do_line		Issue #line output directive.		*/
 /*		doinclude	Process #include directive.		*/
 /*		doline		Process #line directive.		*/
@@ -50,6 +53,13 @@
 
 #include "pp.h"
 
+#include <climits>
+#include <string>
+#include <vector>
+
+/* Every file opened by inc_open() since the last depend_reset() */
+static std::vector<std::string> Depends;
+
 #if HOST == H_CPM
 /************************************************************************/
 /*									*/
@@ -639,6 +649,7 @@ int inc_open(const char *incfile)
         }
         Filelevel++;
         strcpy(f->f_name, incfile);
+        depend_add(incfile);
         LLine = 1;           /* Initial line number		*/
         Bufc = 0;            /* No chars in buffer		*/
         f->f_eof =           /* Not at eof yet		*/
@@ -970,4 +981,73 @@ int trigraph()
     return (c);
 }
 
+/************************************************************************/
+/*									*/
+/*	depend_add							*/
+/*									*/
+/*	Remember a file that was read, by its absolute path, so it can	*/
+/*	be listed in the depfile. Each file is only listed once.	*/
+/*									*/
+/************************************************************************/
+
+void depend_add(const char *file)
+{
+    char path[PATH_MAX];
+
+    if (realpath(file, path) == NULL)
+        strcpy(path, file);
+
+    for (const auto &dep : Depends)
+        if (dep == path)
+            return;
+
+    Depends.emplace_back(path);
+}
+
+/************************************************************************/
+/*									*/
+/*	depend_reset							*/
+/*									*/
+/*	Forget all files remembered by depend_add().			*/
+/*									*/
+/************************************************************************/
+
+void depend_reset()
+{
+    Depends.clear();
+}
+
+/************************************************************************/
+/*									*/
+/*	depend_write							*/
+/*									*/
+/*	Write a Make/Ninja style depfile saying that the space		*/
+/*	separated targets depend on every file read since the last	*/
+/*	depend_reset(). Returns TRUE on success.			*/
+/*									*/
+/************************************************************************/
+
+int depend_write(const char *depfile, const char *targets)
+{
+    FILE *f;
+
+    if ((f = fopen(depfile, "w")) == NULL)
+        return (FALSE);
+
+    fprintf(f, "%s:", targets);
+    for (const auto &dep : Depends)
+    {
+        fputs(" \\\n ", f);
+        for (const char *c = dep.c_str(); *c; c++)
+        {
+            if (*c == ' ')
+                fputc('\\', f);
+            fputc(*c, f);
+        }
+    }
+    fputc('\n', f);
+
+    return (fclose(f) == 0);
+}
+
 #pragma GCC diagnostic pop
@@ -304,6 +304,60 @@ void protocol_send_color(cHook *Hook, ubit16 id, const char *colorstr)
     Hook->Write(buf, 6 + len);
 }
 
+/* Send a string frame of the given type, used for the session messages   */
+static void protocol_send_string(cHook *Hook, const char *header, ubit16 id, const char *str)
+{
+    ubit16 len = 0;
+    ubit8 buf[6 + 1024];
+
+    if (!Hook->IsHooked())
+    {
+        return;
+    }
+
+    len = strlen(str) + 1;
+    assert(len <= 1024);
+
+    memcpy(&(buf[0]), header, 2);
+    memcpy(&(buf[2]), &id, 2);
+    memcpy(&(buf[4]), &len, 2);
+    memcpy(&(buf[6]), str, len);
+
+    Hook->Write(buf, 6 + len);
+}
+
+/* Send (from the server to the mplex'er) the session a player got when    */
+/* logging in. The mplex'er hands it back with a resume request if the     */
+/* server restarts while the player is still connected.                    */
+void protocol_send_session(cHook *Hook, ubit16 id, const char *session)
+{
+    assert(id != 0);
+
+    protocol_send_string(Hook, MULTI_SESSION, id, session);
+}
+
+/* A resume request (from the mplex'er, id zero) or the confirmation of    */
+/* one (from the server, with the new id).                                 */
+void protocol_send_resume(cHook *Hook, ubit16 id, const char *resume)
+{
+    protocol_send_string(Hook, MULTI_RESUME, id, resume);
+}
+
+/* True when a complete frame is waiting in the receive buffer            */
+static bool protocol_frame_ready(const cRxBuffer &rx)
+{
+    ubit16 len = 0;
+
+    if (rx.Bytes() < 6)
+    {
+        return false;
+    }
+
+    memcpy(&len, rx.Data() + 4, sizeof(ubit16));
+
+    return rx.Bytes() - 6 >= len;
+}
+
 /* Data is assumed ready on 'fd' and it is interpreted. Any of the three   */
 /* pointers can be set to NIL if desired.                                  */
 /*                                                                         */
@@ -323,7 +377,7 @@ int protocol_parse_incoming(cHook *Hook, ubit16 *pid, ubit16 *plen, char **str,
     int n = 0;
     ubit16 id = 0;
     ubit16 len = 0;
-    char buf[10];
+    ubit8 type = 0;
     char *data = nullptr;
 
     if (str)
@@ -336,20 +390,24 @@ int protocol_parse_incoming(cHook *Hook, ubit16 *pid, ubit16 *plen, char **str,
         return 0;
     }
 
-    n = Hook->ReadToQueue();
-
-    if (n == -1)
+    /* Only go to the socket once the frames already buffered are used up */
+    if (!protocol_frame_ready(Hook->bufRX))
     {
-        slog(LOG_ALL, 0, "Protocol: parse_incoming error.");
-        return -1;
+        n = Hook->ReadToBuffer();
+
+        if (n == -1)
+        {
+            slog(LOG_ALL, 0, "Protocol: parse_incoming error.");
+            return -1;
+        }
     }
 
-    if (Hook->qRX.Bytes() < 6)
+    if (Hook->bufRX.Bytes() < 6)
     {
         return 0;
     }
 
-    Hook->qRX.Copy((ubit8 *)buf, 6);
+    const ubit8 *buf = Hook->bufRX.Data();
 
     if (buf[0] != MULTI_UNIQUE_CHAR)
     {
@@ -361,13 +419,14 @@ int protocol_parse_incoming(cHook *Hook, ubit16 *pid, ubit16 *plen, char **str,
     memcpy(&id, &(buf[2]), sizeof(ubit16));
     memcpy(&len, &(buf[4]), sizeof(sbit16));
 
-    if (Hook->qRX.Bytes() - 6 < len)
+    if (Hook->bufRX.Bytes() - 6 < len)
     {
         // slog(LOG_ALL, 0, "Short of data...");
         return 0; /* We havn't got all the data yet! */
     }
 
-    Hook->qRX.Cut(6);
+    type = buf[1];
+    Hook->bufRX.Cut(6);
 
     if (pid)
     {
@@ -379,7 +438,7 @@ int protocol_parse_incoming(cHook *Hook, ubit16 *pid, ubit16 *plen, char **str,
         *plen = len;
     }
 
-    switch (buf[1])
+    switch (type)
     {
         case MULTI_MPLEX_INFO_CHAR:
             break; // Get the data (down below)
@@ -391,7 +450,7 @@ int protocol_parse_incoming(cHook *Hook, ubit16 *pid, ubit16 *plen, char **str,
                 return -2;
             }
             // slog(LOG_ALL, 0, "Ping received");
-            return buf[1];
+            return type;
 
         case MULTI_TERMINATE_CHAR:
             if (id == 0)
@@ -399,7 +458,7 @@ int protocol_parse_incoming(cHook *Hook, ubit16 *pid, ubit16 *plen, char **str,
                 slog(LOG_ALL, 0, "Received ID zero on a terminate request!");
                 return -2;
             }
-            return buf[1];
+            return type;
 
         case MULTI_CONNECT_CON_CHAR:
             // slog(LOG_ALL, 0, "MULTI_CONNECT_CON_CHAR protocol_parse_incoming() ID=%d", id);
@@ -408,7 +467,7 @@ int protocol_parse_incoming(cHook *Hook, ubit16 *pid, ubit16 *plen, char **str,
                 slog(LOG_ALL, 0, "ID 0 on connection confirm.");
                 return -2;
             }
-            return buf[1];
+            return type;
 
         case MULTI_CONNECT_REQ_CHAR:
             // slog(LOG_ALL, 0, "MULTI_CONNECT_REQ_CHAR protocol_parse_incoming()", id);
@@ -417,7 +476,7 @@ int protocol_parse_incoming(cHook *Hook, ubit16 *pid, ubit16 *plen, char **str,
                 slog(LOG_ALL, 0, "Received non-zero ID on a connection request!");
                 return -2;
             }
-            return buf[1];
+            return type;
 
         case MULTI_HOST_CHAR:
             if (id == 0)
@@ -465,6 +524,22 @@ int protocol_parse_incoming(cHook *Hook, ubit16 *pid, ubit16 *plen, char **str,
             }
             break; /* Get text */
 
+        case MULTI_SESSION_CHAR:
+            if (id == 0)
+            {
+                slog(LOG_ALL, 0, "Received session for ID zero!");
+                return -2;
+            }
+            [[fallthrough]];
+
+        case MULTI_RESUME_CHAR:
+            if (len <= 0)
+            {
+                slog(LOG_ALL, 0, "Received 0 length session information.");
+                return -2;
+            }
+            break; /* Get text */
+
         default:
             slog(LOG_ALL, 0, "Illegal unexpected unique multi character.#3");
             return -2;
@@ -475,13 +550,13 @@ int protocol_parse_incoming(cHook *Hook, ubit16 *pid, ubit16 *plen, char **str,
 
     CREATE(data, char, len + 1);
 
-    Hook->qRX.CutCopy((ubit8 *)data, len);
+    Hook->bufRX.CutCopy((ubit8 *)data, len);
 
     data[len] = 0;
 
     *str = data;
 
-    return buf[1];
+    return type;
 }
 
 void terminal_setup_type::toJSON(rapidjson::PrettyWriter<rapidjson::StringBuffer> &writer) const
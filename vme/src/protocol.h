@@ -44,6 +44,8 @@ struct terminal_setup_type
 #define MULTI_COLOR_CHAR 'J'
 #define MULTI_PING_CHAR 'K'
 #define MULTI_MPLEX_INFO_CHAR 'L'
+#define MULTI_SESSION_CHAR 'M'
+#define MULTI_RESUME_CHAR 'N'
 
 #define MULTI_CONNECT_REQ_STR "A"
 #define MULTI_CONNECT_CON_STR "B"
@@ -57,6 +59,8 @@ struct terminal_setup_type
 #define MULTI_COLOR_STR "J"
 #define MULTI_PING_STR "K"
 #define MULTI_MPLEX_INFO_STR "L"
+#define MULTI_SESSION_STR "M"
+#define MULTI_RESUME_STR "N"
 
 #define MULTI_EXCHANGE MULTI_UNIQUE_STR MULTI_EXCHANGE_STR "\0\0\0\0"
 #define MULTI_COLOR MULTI_UNIQUE_STR MULTI_COLOR_STR "\0\0\0\0"
@@ -67,6 +71,8 @@ struct terminal_setup_type
 #define MULTI_HOST MULTI_UNIQUE_STR MULTI_HOST_STR "\0\0\0\0"
 #define MULTI_PING MULTI_UNIQUE_STR MULTI_PING_STR "\0\0\0\0"
 #define MULTI_MPLEX_INFO MULTI_UNIQUE_STR MULTI_MPLEX_INFO_STR "\0\0\0\0"
+#define MULTI_SESSION MULTI_UNIQUE_STR MULTI_SESSION_STR
+#define MULTI_RESUME MULTI_UNIQUE_STR MULTI_RESUME_STR
 
 #define MULTI_TEXT MULTI_UNIQUE_STR MULTI_TXT_STR
 #define MULTI_PAGE MULTI_UNIQUE_STR MULTI_TXT_STR
@@ -85,3 +91,5 @@ void protocol_send_color(cHook *Hook, ubit16 id, const char *color);
 void protocol_send_host(cHook *Hook, ubit16 id, const char *host, ubit16 nPort, ubit8 nLine);
 int protocol_parse_incoming(cHook *Hook, ubit16 *pid, ubit16 *plen, char **str, ubit8 *text_type);
 void protocol_send_mplex_info(cHook *Hook, ubit8 bWebsockets);
+void protocol_send_session(cHook *Hook, ubit16 id, const char *session);
+void protocol_send_resume(cHook *Hook, ubit16 id, const char *resume);
@@ -124,26 +124,16 @@ void room_data::setRoomNumber(int value)
     m_num = value;
 }
 
-std::vector<room_data::vertex_descriptor> &room_data::getPath()
+std::vector<ubit8> &room_data::getPath()
 {
     return m_path;
 }
 
-const std::vector<room_data::vertex_descriptor> &room_data::getPath() const
+const std::vector<ubit8> &room_data::getPath() const
 {
     return m_path;
 }
 
-std::vector<room_data::vertex_descriptor> &room_data::getDistance()
-{
-    return m_distance;
-}
-
-const std::vector<room_data::vertex_descriptor> &room_data::getDistance() const
-{
-    return m_distance;
-}
-
 bool room_data::getWaitingDijkstra() const
 {
     return m_waiting_dijkstra;
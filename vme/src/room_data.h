@@ -145,20 +145,15 @@ public:
 
     /**
      * @name Path
+     * First hop direction (DIR_XXX) towards every room of the strong
+     * component, indexed by room number. Empty until the shortest path
+     * thread has been through this room.
      * @{
      */
-    std::vector<vertex_descriptor> &getPath();
-    const std::vector<vertex_descriptor> &getPath() const;
+    std::vector<ubit8> &getPath();
+    const std::vector<ubit8> &getPath() const;
     ///@}
 
-    /**
-     * @name Distance
-     * @{
-     */
-    std::vector<vertex_descriptor> &getDistance();
-    const std::vector<vertex_descriptor> &getDistance() const;
-    /// @}
-
     /**
      * @name
      * @{
@@ -167,7 +162,6 @@ public:
     void setWaitingDijkstra(bool value);
     /// @}
 private:
-    std::vector<vertex_descriptor> m_path;     ///<
-    std::vector<vertex_descriptor> m_distance; ///<
-    bool m_waiting_dijkstra{false};            ///<
+    std::vector<ubit8> m_path;      ///< First hop direction by room number
+    bool m_waiting_dijkstra{false}; ///<
 };
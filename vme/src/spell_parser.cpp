@@ -7,6 +7,7 @@
 #include "comm.h"
 #include "db.h"
 #include "dilrun.h"
+#include "dilstring.h"
 #include "files.h"
 #include "formatter.h"
 #include "handler.h"
@@ -219,9 +220,9 @@ int spell_perform(int spell_no,
 
             prg->fp->vars[0].val.unitptr = medium;
             prg->fp->vars[1].val.unitptr = target;
-            prg->fp->vars[2].val.string = str_dup(argument);
+            prg->fp->vars[2].val.string = dilstr_new(argument);
             prg->fp->vars[3].val.integer = hm;
-            prg->fp->vars[4].val.string = str_dup(pEffect);
+            prg->fp->vars[4].val.string = dilstr_new(pEffect);
 
             dil_add_secure(prg, medium, prg->fp->tmpl->core);
             dil_add_secure(prg, target, prg->fp->tmpl->core);
@@ -127,7 +127,11 @@ int g_max_no_connections = 0; /* Statistics                                */
 /* Note that id zero signifies that mplex descriptor has no mplex'er    */
 descriptor_data *descriptor_new(cMultiHook *pe)
 {
-    return new descriptor_data(pe);
+    auto *d = new descriptor_data(pe);
+
+    pe->AddDescriptor(d);
+
+    return d;
 }
 
 /* Flush should be set to true, when there is noone to receive the  */
@@ -226,6 +230,8 @@ void descriptor_close(descriptor_data *d, int bSendClose, int bReconnect)
         protocol_send_close(d->getMultiHookPtr(), d->getMultiHookID());
     }
 
+    d->getMultiHookPtr()->RemoveDescriptor(d);
+
     g_no_connections--;
 
     if (g_next_to_process == d)
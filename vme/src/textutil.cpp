@@ -1309,15 +1309,74 @@ ubit32 inline utf8_decode(ubit32 *state, ubit32 *codep, ubit8 byte)
     return *state;
 }
 
-void str_correct_utf8(char *src)
+// Word-at-a-time (SWAR) helpers for the ASCII fast paths below. Eight bytes
+// are loaded with memcpy so there are no alignment or aliasing assumptions,
+// and the callers never load past the end of the string.
+static constexpr ubit64 SWAR_ONES = 0x0101010101010101ULL;
+static constexpr ubit64 SWAR_HIGH = 0x8080808080808080ULL;
+
+static inline ubit64 swar_load(const char *p)
+{
+    ubit64 w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+// True if any byte in w has its high bit set (i.e. is not ASCII)
+static inline bool swar_has_nonascii(ubit64 w)
+{
+    return (w & SWAR_HIGH) != 0;
+}
+
+// True if any byte in w is less than n. Only valid for ASCII words and n <= 128.
+static inline bool swar_has_less(ubit64 w, ubit8 n)
+{
+    return ((w - SWAR_ONES * n) & ~w & SWAR_HIGH) != 0;
+}
+
+// True if any byte in w equals c
+static inline bool swar_has_byte(ubit64 w, ubit8 c)
+{
+    ubit64 x = w ^ (SWAR_ONES * c);
+    return ((x - SWAR_ONES) & ~x & SWAR_HIGH) != 0;
+}
+
+// Returns the length of the pure ASCII run starting at s (at most len bytes)
+static size_t ascii_run_length(const char *s, size_t len)
+{
+    size_t n = 0;
+
+    while (n + sizeof(ubit64) <= len && !swar_has_nonascii(swar_load(s + n)))
+    {
+        n += sizeof(ubit64);
+    }
+
+    while (n < len && (s[n] & 0x80) == 0)
+    {
+        n++;
+    }
+
+    return n;
+}
+
+static void str_correct_utf8(char *src, size_t len)
 {
     ubit32 codepoint = 0;
     ubit32 prev = 0;
     ubit32 current = 0;
     char *s = src;
+    char *end = src + len;
 
-    for (; *s; prev = current, s++)
+    for (; s < end; prev = current, s++)
     {
+        // ASCII bytes from the accept state always stay in the accept state,
+        // so whole runs of them can be skipped without running the DFA.
+        if (current == UTF8_ACCEPT && (*s & 0x80) == 0)
+        {
+            s += ascii_run_length(s, end - s) - 1;
+            continue;
+        }
+
         if (utf8_decode(&current, &codepoint, *s) == UTF8_REJECT)
         {
             // The byte is invalid, replace it and restart.
@@ -1345,6 +1404,11 @@ void str_correct_utf8(char *src)
     }
 }
 
+void str_correct_utf8(char *src)
+{
+    str_correct_utf8(src, strlen(src));
+}
+
 void str_correct_utf8(std::string &src)
 {
     str_correct_utf8((char *)src.c_str());
@@ -1402,6 +1466,37 @@ void obs_str_correct_utf8(std::string &src)
     } // end for
 }
 
+// Plain bytes are copied verbatim by html_encode_utf8: printable ASCII
+// other than space and the characters that need an HTML entity.
+static inline bool is_html_plain(char c)
+{
+    return c > ' ' && c != '&' && c != '\"' && c != '<' && c != '>';
+}
+
+static inline bool swar_is_html_plain(ubit64 w)
+{
+    return !swar_has_nonascii(w) && !swar_has_less(w, ' ' + 1) && !swar_has_byte(w, '&') && !swar_has_byte(w, '\"') &&
+           !swar_has_byte(w, '<') && !swar_has_byte(w, '>');
+}
+
+// Returns the length of the run of plain bytes starting at s (at most len bytes)
+static size_t html_plain_run_length(const char *s, size_t len)
+{
+    size_t n = 0;
+
+    while (n + sizeof(ubit64) <= len && swar_is_html_plain(swar_load(s + n)))
+    {
+        n += sizeof(ubit64);
+    }
+
+    while (n < len && is_html_plain(s[n]))
+    {
+        n++;
+    }
+
+    return n;
+}
+
 // This both encodes and prepares string for interpreter.
 // Removes all leading and trailing whitespace.
 // Ensures only one whitespace between each word.
@@ -1428,6 +1523,15 @@ char *html_encode_utf8(const char *src)
 
     for (; pos < nLen; ++pos)
     {
+        // Copy runs of plain text in one go, only special bytes take the slow path
+        int nRun = html_plain_run_length(&src[pos], nLen - pos);
+        if (nRun > 0)
+        {
+            sBuffer.append(&src[pos], nRun);
+            pos += nRun - 1;
+            continue;
+        }
+
         if ((src[pos] & 0x80) == 0) // lead bit is zero, must be a single ascii
         {
             if (src[pos] < 32)
@@ -1925,3 +2029,25 @@ int pwdcompare(const char *p1, const char *p2, int nMax)
 
     return 0;
 }
+
+// Compare a secret hash 'p1' to a guess 'p2' in a time that only depends
+// on their lengths, so timing does not tell how much of a guess was right.
+// return 0 = match, 1 = differ
+int hashcompare(const char *p1, const char *p2)
+{
+    if ((p1 == nullptr) || (p2 == nullptr))
+    {
+        return 1;
+    }
+
+    size_t n1 = strlen(p1);
+    size_t n2 = strlen(p2);
+    ubit8 diff = (n1 != n2);
+
+    for (size_t i = 0; i < n1; i++)
+    {
+        diff |= (ubit8)p1[i] ^ (ubit8)(i < n2 ? p2[i] : 0);
+    }
+
+    return diff != 0;
+}
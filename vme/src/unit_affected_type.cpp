@@ -144,6 +144,16 @@ void unit_affected_type::setEventQueueElement(eventq_elem *value)
     event = value;
 }
 
+int unit_affected_type::getBeatDue() const
+{
+    return beat_due;
+}
+
+void unit_affected_type::setBeatDue(int value)
+{
+    beat_due = value;
+}
+
 const unit_data *unit_affected_type::cgetOwner() const
 {
     return owner;
@@ -45,6 +45,9 @@ public:
     eventq_elem *getEventQueueElement();
     void setEventQueueElement(eventq_elem *value);
 
+    int getBeatDue() const;
+    void setBeatDue(int value);
+
     const unit_data *cgetOwner() const;
     unit_data *getOwner();
     void setOwner(unit_data *value);
@@ -71,7 +74,8 @@ private:
     sbit16 tickf_i{0};                      ///<
     sbit16 lastf_i{0};                      ///<
     sbit16 applyf_i{0};                     ///<
-    eventq_elem *event{nullptr};            ///< pointer to eventq for quick removing
+    eventq_elem *event{nullptr};            ///< shared beat event of the owner, see affect_beat
+    int beat_due{0};                        ///< g_tics when the next tick is due
     unit_data *owner{nullptr};              ///<
     unit_affected_type *next{nullptr};      ///<
     unit_affected_type *gnext{nullptr};     ///<
@@ -18,6 +18,8 @@
     #include "vmc/vmc_process.h"
 #endif
 
+#include <cstddef>
+
 unit_data *new_unit_data(ubit8 type, file_index_type *fi)
 {
     if (type == UNIT_ST_ROOM)
@@ -44,33 +46,45 @@ unit_data *new_unit_data(ubit8 type, file_index_type *fi)
 }
 
 unit_data::unit_data(ubit8 type, file_index_type *fi)
-    : m_func{nullptr}
-    , m_affected{nullptr}
-    , m_fi{nullptr}
-    , m_key{nullptr}
+    : m_status{type}
+    , m_open_flags{0}
+    , m_flags{0}
+    , m_chars{0}
+    , m_minv{0}
     , m_outside{nullptr}
     , m_inside{nullptr}
     , m_next{nullptr}
     , m_gnext{nullptr}
     , m_gprevious{nullptr}
+    , m_fi{nullptr}
+    , m_char_inside{nullptr}
+    , m_char_next{nullptr}
+    , m_char_holders{0}
+    , m_lifted_zone{nullptr}
+    , m_func{nullptr}
+    , m_affected{nullptr}
+    , m_key{nullptr}
     , m_manipulate{0}
-    , m_flags{0}
     , m_base_weight{0}
     , m_weight{0}
     , m_capacity{0}
     , m_size{0}
-    , m_status{type}
-    , m_open_flags{0}
     , m_open_diff{0}
     , m_light{0}
     , m_bright{0}
     , m_illum{0}
-    , m_chars{0}
-    , m_minv{0}
+    , m_alignment{0}
     , m_max_hp{0}
     , m_hp{0}
-    , m_alignment{0}
 {
+    // unit_data is not standard layout (it has a vtable), but GCC and clang
+    // lay members out in declaration order after the base, which is all we rely on.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+    static_assert(offsetof(unit_data, m_status) < offsetof(unit_data, m_fi), "Keep the hot fields together");
+    static_assert(offsetof(unit_data, m_fi) + sizeof(m_fi) <= 64, "Hot unit_data fields must fit the first cache line");
+#pragma GCC diagnostic pop
+
     assert((type == UNIT_ST_ROOM) || (type == UNIT_ST_OBJ) || (type == UNIT_ST_PC) || (type == UNIT_ST_NPC));
     // assert(fi);  -- Ideally some day it will be impossible to create a unit without a file_index
     m_status = type;
@@ -485,6 +499,71 @@ void unit_data::setUnitContains(unit_data *value)
     m_inside = value;
 }
 
+const unit_data *unit_data::getCharContains() const
+{
+    return m_char_inside;
+}
+
+unit_data *unit_data::getCharContains()
+{
+    return m_char_inside;
+}
+
+void unit_data::setCharContains(unit_data *value)
+{
+    m_char_inside = value;
+}
+
+const unit_data *unit_data::getNextChar() const
+{
+    return m_char_next;
+}
+
+unit_data *unit_data::getNextChar()
+{
+    return m_char_next;
+}
+
+void unit_data::setNextChar(unit_data *value)
+{
+    m_char_next = value;
+}
+
+ubit8 unit_data::getNumberOfCharacterHoldersInsideUnit() const
+{
+    return m_char_holders;
+}
+
+void unit_data::decrementNumberOfCharacterHoldersInsideUnit()
+{
+    --m_char_holders;
+}
+
+void unit_data::incrementNumberOfCharacterHoldersInsideUnit()
+{
+    ++m_char_holders;
+}
+
+bool unit_data::charsInCharList(const unit_data *except) const
+{
+    if (m_char_holders == 0)
+    {
+        return true;
+    }
+
+    return m_char_holders == 1 && except && except->m_outside == this && !except->isChar() && except->m_char_inside;
+}
+
+zone_type *unit_data::getLiftedZone() const
+{
+    return m_lifted_zone;
+}
+
+void unit_data::setLiftedZone(zone_type *value)
+{
+    m_lifted_zone = value;
+}
+
 const unit_data *unit_data::getNext() const
 {
     return m_next;
@@ -165,6 +165,41 @@ public:
     const unit_data *getUnitContains() const;
     unit_data *getUnitContains();
     void setUnitContains(unit_data *value);
+
+    /**
+     * The characters inside are also linked in a list of their own, in the
+     * same order as in the getUnitContains() list. Maintained by
+     * unit_to_unit() and unit_from_unit().
+     */
+    const unit_data *getCharContains() const;
+    unit_data *getCharContains();
+    void setCharContains(unit_data *value);
+
+    const unit_data *getNextChar() const;
+    unit_data *getNextChar();
+    void setNextChar(unit_data *value);
+
+    /// Number of units inside, other than characters, which have characters inside them
+    ubit8 getNumberOfCharacterHoldersInsideUnit() const;
+    void decrementNumberOfCharacterHoldersInsideUnit();
+    void incrementNumberOfCharacterHoldersInsideUnit();
+
+    /**
+     * True when walking getCharContains() (and on down through the characters
+     * found) reaches every character inside, i.e. no other unit inside holds
+     * characters. A non character unit inside may be named in 'except' when
+     * the caller does not look into it anyway.
+     */
+    bool charsInCharList(const unit_data *except = nullptr) const;
+
+    /**
+     * The zone a unit taken out to the top level by unit_from_unit() is
+     * still counted in, or nullptr when it is counted where it is. The unit
+     * and its contents are recounted when it enters a unit again or leaves
+     * the game, so moving within a zone never walks the contents.
+     */
+    zone_type *getLiftedZone() const;
+    void setLiftedZone(zone_type *value);
     /// @}
 
     /**
@@ -374,33 +409,42 @@ public:
     [[nodiscard]] std::string getID() const { return m_fi->getSymName(); }
 
 private:
-    cNamelist m_names;                       ///< Name Keyword list for get, enter, etc.
-    unit_fptr *m_func{nullptr};              ///< Function pointer type
-    unit_affected_type *m_affected{nullptr}; ///<
-    file_index_type *m_fi{nullptr};          ///< Unit file-index
-    char *m_key{nullptr};                    ///< Pointer to fileindex to Unit which is the key
+    // Hot fields first: list walks and scans (g_unit_list, contents chains,
+    // scan4_unit) only touch these, so keep them within the first cache line.
+    // The layout is checked in the constructor.
+    ubit8 m_status{0};                       ///< IS_ROOM, IS_OBJ, IS_PC, IS_NPC
+    ubit8 m_open_flags{0};                   ///< In general OPEN will mean can "enter"?
+    ubit16 m_flags{0};                       ///< Invisible, can_bury, burried...
+    ubit8 m_chars{0};                        ///< How many chars is inside the unit
+    ubit8 m_minv{0};                         ///< Level of wizard invisible
     unit_data *m_outside{nullptr};           ///< Pointer out of the unit, ie. from an object out to the char carrying it
     unit_data *m_inside{nullptr};            ///< Linked list of chars,rooms & objs
     unit_data *m_next{nullptr};              ///< For next unit in 'inside' linked list
     unit_data *m_gnext{nullptr};             ///< global l-list of objects, chars & rooms
     unit_data *m_gprevious{nullptr};         ///< global l-list of objects, chars & rooms
+    file_index_type *m_fi{nullptr};          ///< Unit file-index
+    // Walked instead of 'inside' when only chars are looked for
+    unit_data *m_char_inside{nullptr};       ///< Linked list of the chars in 'inside'
+    unit_data *m_char_next{nullptr};         ///< For next char in 'char_inside' linked list
+    ubit8 m_char_holders{0};                 ///< How many non chars inside have chars inside
+    // Cold fields
+    zone_type *m_lifted_zone{nullptr};       ///< Zone still counted in while at the top level
+    unit_fptr *m_func{nullptr};              ///< Function pointer type
+    unit_affected_type *m_affected{nullptr}; ///<
+    char *m_key{nullptr};                    ///< Pointer to fileindex to Unit which is the key
     ubit32 m_manipulate{0};                  ///< WEAR_XXX macros
-    ubit16 m_flags{0};                       ///< Invisible, can_bury, burried...
     sbit32 m_base_weight{0};                 ///< The "empty" weight of a room/char/obj (lbs)
     sbit32 m_weight{0};                      ///< Current weight of a room/obj/char
     sbit16 m_capacity{0};                    ///< Capacity of obj/char/room, -1 => any
     ubit16 m_size{0};                        ///< (cm) MOBs height, weapons size, ropes length
-    ubit8 m_status{0};                       ///< IS_ROOM, IS_OBJ, IS_PC, IS_NPC
-    ubit8 m_open_flags{0};                   ///< In general OPEN will mean can "enter"?
     ubit8 m_open_diff{0};                    ///< Open difficulty
     sbit16 m_light{0};                       ///< Number of active light sources in unit
     sbit16 m_bright{0};                      ///< How much the unit shines
     sbit16 m_illum{0};                       ///< how much bright is by transparency
-    ubit8 m_chars{0};                        ///< How many chars is inside the unit
-    ubit8 m_minv{0};                         ///< Level of wizard invisible
+    sbit16 m_alignment{0};                   ///< +-1000 for alignments
     sbit32 m_max_hp{0};                      ///< The maximum number of hitpoints
     sbit32 m_hp{0};                          ///< The actual amount of hitpoints left
-    sbit16 m_alignment{0};                   ///< +-1000 for alignments
+    cNamelist m_names;                       ///< Name Keyword list for get, enter, etc.
     std::string m_title;                     ///< Room title, Char title, Obj "the barrel", NPC "the Beastly Fido"
     std::string m_out_descr;                 ///< The outside description of a unit
     std::string m_in_descr;                  ///< The inside description of a unit
@@ -315,6 +315,24 @@ unit_data *random_unit(unit_data *ref, int sflags, int tflags)
     return nullptr;
 }
 
+/* Characters inside a unit are also linked in a list of their own, in   */
+/* the same order as the contents. When only characters are looked for  */
+/* that list is walked instead, skipping the objects in between.        */
+static inline bool scan_chars_only(ubit8 type)
+{
+    return !IS_SET(type, UNIT_ST_OBJ | UNIT_ST_ROOM);
+}
+
+static inline unit_data *scan_first(const unit_data *in, bool chars)
+{
+    return const_cast<unit_data *>(chars ? in->getCharContains() : in->getUnitContains());
+}
+
+static inline unit_data *scan_next(const unit_data *u, bool chars)
+{
+    return const_cast<unit_data *>(chars ? u->getNextChar() : u->getNext());
+}
+
 unit_data *find_unit_general_abbrev(const unit_data *viewer,
                                     const unit_data *ch,
                                     char **arg,
@@ -332,6 +350,7 @@ unit_data *find_unit_general_abbrev(const unit_data *viewer,
     char *c = nullptr;
     unit_data *u = nullptr;
     unit_data *uu = nullptr;
+    bool chars = false;
 
     if (!viewer->isPC() || (type == 0))
     {
@@ -445,8 +464,10 @@ unit_data *find_unit_general_abbrev(const unit_data *viewer,
                 }
             }
 
-            /* Run through units in local environment */
-            for (u = const_cast<unit_data *>(ch->getUnitIn()->getUnitContains()); u; u = u->getNext())
+            /* Run through units in local environment. Only units of the */
+            /* type looked for are looked into, so chars need only chars */
+            chars = scan_chars_only(type);
+            for (u = scan_first(ch->getUnitIn(), chars); u; u = scan_next(u, chars))
             {
                 if (IS_SET(type, u->getUnitType()) && (u->isRoom() || CHAR_CAN_SEE(viewer, u))) /* Cansee room in dark */
                 {
@@ -467,7 +488,7 @@ unit_data *find_unit_general_abbrev(const unit_data *viewer,
                     /* check tranparancy */
                     if (u->getNumberOfCharactersInsideUnit() && u->isTransparent())
                     {
-                        for (uu = u->getUnitContains(); uu; uu = uu->getNext())
+                        for (uu = u->getCharContains(); uu; uu = uu->getNextChar())
                         {
                             if (IS_SET(type, uu->getUnitType()) && uu->isChar() && (ct = uu->getNames().IsNameRawAbbrev(c)) &&
                                 CHAR_CAN_SEE(viewer, uu) && (ct - c >= best_len))
@@ -492,7 +513,8 @@ unit_data *find_unit_general_abbrev(const unit_data *viewer,
             /* Run through units in local environment if upwards transparent */
             if ((u = const_cast<unit_data *>(ch->getUnitIn()->getUnitIn())) && ch->getUnitIn()->isTransparent())
             {
-                for (u = u->getUnitContains(); u; u = u->getNext())
+                chars = scan_chars_only(type) && u->charsInCharList(ch->getUnitIn());
+                for (u = scan_first(u, chars); u; u = scan_next(u, chars))
                 {
                     if (u != ch->getUnitIn() && CHAR_CAN_SEE(viewer, u))
                     {
@@ -513,7 +535,7 @@ unit_data *find_unit_general_abbrev(const unit_data *viewer,
                         /* check down into transparent unit */
                         if (u->getNumberOfCharactersInsideUnit() && u->isTransparent())
                         {
-                            for (uu = u->getUnitContains(); uu; uu = uu->getNext())
+                            for (uu = u->getCharContains(); uu; uu = uu->getNextChar())
                             {
                                 if (IS_SET(type, uu->getUnitType()) && uu->isChar() && (ct = uu->getNames().IsNameRawAbbrev(c)) &&
                                     CHAR_CAN_SEE(viewer, uu) && (ct - c >= best_len))
@@ -587,6 +609,7 @@ find_unit_general(const unit_data *viewer, const unit_data *ch, char **arg, cons
     ubit1 is_fillword = TRUE;
     unit_data *u = nullptr;
     unit_data *uu = nullptr;
+    bool chars = false;
 
     if (type == 0)
     {
@@ -731,8 +754,10 @@ find_unit_general(const unit_data *viewer, const unit_data *ch, char **arg, cons
                     }
                 }
 
-                /* Run through units in local environment */
-                for (u = const_cast<unit_data *>(ch->getUnitIn()->getUnitContains()); u; u = u->getNext())
+                /* Run through units in local environment. Only units of the */
+                /* type looked for are looked into, so chars need only chars */
+                chars = scan_chars_only(type);
+                for (u = scan_first(ch->getUnitIn(), chars); u; u = scan_next(u, chars))
                 {
                     if (IS_SET(type, u->getUnitType()) && (u->isRoom() || CHAR_CAN_SEE(viewer, u))) /* Cansee room in dark */
                     {
@@ -753,7 +778,7 @@ find_unit_general(const unit_data *viewer, const unit_data *ch, char **arg, cons
                         /* check tranparancy */
                         if (u->getNumberOfCharactersInsideUnit() && u->isTransparent())
                         {
-                            for (uu = u->getUnitContains(); uu; uu = uu->getNext())
+                            for (uu = u->getCharContains(); uu; uu = uu->getNextChar())
                             {
                                 if (IS_SET(type, uu->getUnitType()) && uu->isChar() && (ct = uu->getNames().IsNameRaw(c)) &&
                                     CHAR_CAN_SEE(viewer, uu) && (ct - c >= best_len))
@@ -778,7 +803,8 @@ find_unit_general(const unit_data *viewer, const unit_data *ch, char **arg, cons
                 /* Run through units in local environment if upwards transparent */
                 if ((u = const_cast<unit_data *>(ch->getUnitIn()->getUnitIn())) && ch->getUnitIn()->isTransparent())
                 {
-                    for (u = u->getUnitContains(); u; u = u->getNext())
+                    chars = scan_chars_only(type) && u->charsInCharList(ch->getUnitIn());
+                    for (u = scan_first(u, chars); u; u = scan_next(u, chars))
                     {
                         if (u != ch->getUnitIn() && CHAR_CAN_SEE(viewer, u))
                         {
@@ -799,7 +825,7 @@ find_unit_general(const unit_data *viewer, const unit_data *ch, char **arg, cons
                             /* check down into transparent unit */
                             if (u->getNumberOfCharactersInsideUnit() && u->isTransparent())
                             {
-                                for (uu = u->getUnitContains(); uu; uu = uu->getNext())
+                                for (uu = u->getCharContains(); uu; uu = uu->getNextChar())
                                 {
                                     if (IS_SET(type, uu->getUnitType()) && uu->isChar() && (ct = uu->getNames().IsNameRaw(c)) &&
                                         CHAR_CAN_SEE(viewer, uu) && (ct - c >= best_len))
@@ -1021,6 +1047,8 @@ void scan4_unit_room(unit_data *room, ubit8 type)
 {
     unit_data *u = nullptr;
     unit_data *uu = nullptr;
+    const bool only_chars = scan_chars_only(type);
+    bool chars = false;
 
     g_unit_vector.top = 0;
 
@@ -1029,7 +1057,8 @@ void scan4_unit_room(unit_data *room, ubit8 type)
         init_unit_vector();
     }
 
-    for (u = room->getUnitContains(); u; u = u->getNext())
+    chars = only_chars && room->charsInCharList();
+    for (u = scan_first(room, chars); u; u = scan_next(u, chars))
     {
         if (IS_SET(u->getUnitType(), type))
         {
@@ -1043,7 +1072,7 @@ void scan4_unit_room(unit_data *room, ubit8 type)
         /* down into transparent unit */
         if (u->isTransparent())
         {
-            for (uu = u->getUnitContains(); uu; uu = uu->getNext())
+            for (uu = scan_first(u, only_chars); uu; uu = scan_next(uu, only_chars))
             {
                 if (IS_SET(uu->getUnitType(), type))
                 {
@@ -1068,6 +1097,8 @@ void scan4_unit(unit_data *ch, ubit8 type)
 {
     unit_data *u = nullptr;
     unit_data *uu = nullptr;
+    const bool only_chars = scan_chars_only(type);
+    bool chars = false;
 
     if (!ch->getUnitIn())
     {
@@ -1082,7 +1113,8 @@ void scan4_unit(unit_data *ch, ubit8 type)
         init_unit_vector();
     }
 
-    for (u = ch->getUnitIn()->getUnitContains(); u; u = u->getNext())
+    chars = only_chars && ch->getUnitIn()->charsInCharList();
+    for (u = scan_first(ch->getUnitIn(), chars); u; u = scan_next(u, chars))
     {
         if (u != ch && IS_SET(u->getUnitType(), type))
         {
@@ -1096,7 +1128,7 @@ void scan4_unit(unit_data *ch, ubit8 type)
         /* down into transparent unit */
         if (u->isTransparent())
         {
-            for (uu = u->getUnitContains(); uu; uu = uu->getNext())
+            for (uu = scan_first(u, only_chars); uu; uu = scan_next(uu, only_chars))
             {
                 if (IS_SET(uu->getUnitType(), type))
                 {
@@ -1113,7 +1145,8 @@ void scan4_unit(unit_data *ch, ubit8 type)
     /* up through transparent unit */
     if (ch->getUnitIn()->isTransparent() && ch->getUnitIn()->getUnitIn())
     {
-        for (u = ch->getUnitIn()->getUnitIn()->getUnitContains(); u; u = u->getNext())
+        chars = only_chars && ch->getUnitIn()->getUnitIn()->charsInCharList(ch->getUnitIn());
+        for (u = scan_first(ch->getUnitIn()->getUnitIn(), chars); u; u = scan_next(u, chars))
         {
             if (IS_SET(u->getUnitType(), type))
             {
@@ -1127,7 +1160,7 @@ void scan4_unit(unit_data *ch, ubit8 type)
             /* down into transparent unit */
             if (u->isTransparent() && u != ch->getUnitIn())
             {
-                for (uu = u->getUnitContains(); uu; uu = uu->getNext())
+                for (uu = scan_first(u, only_chars); uu; uu = scan_next(uu, only_chars))
                 {
                     if (IS_SET(uu->getUnitType(), type))
                     {
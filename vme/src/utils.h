@@ -101,8 +101,7 @@ inline int ROOM_NUM(const unit_data *unit) { return UROOM(unit)->getRoomNumber()
 
 inline int ROOM_SC(const unit_data *unit) { return UROOM(unit)->getStrongComponent(); }
 
-inline std::vector<room_data::vertex_descriptor> &ROOM_PATH(unit_data *unit) { return UROOM(unit)->getPath(); }
-inline std::vector<room_data::vertex_descriptor> &ROOM_DISTANCE(unit_data *unit) { return UROOM(unit)->getDistance();}
+inline std::vector<ubit8> &ROOM_PATH(unit_data *unit) { return UROOM(unit)->getPath(); }
 
 /* ..................................................................... */
 
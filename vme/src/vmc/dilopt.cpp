@@ -0,0 +1,92 @@
+/*
+ * The parts of the DIL optimiser (vmc -O) that work on the generated
+ * code alone, kept out of dilpar.y so they can be tested on their own.
+ */
+#include "dilopt.h"
+
+#include "bytestring.h"
+#include "dil.h"
+
+/*
+ * Evaluate an integer compare of two constants the way the interpreter
+ * would. Returns false if 'op' is not an integer compare.
+ */
+bool dil_fold_compare(int op, sbit32 a, sbit32 b, sbit32 *result)
+{
+    switch (op)
+    {
+        case DILE_EQ:
+            *result = (a == b);
+            return true;
+        case DILE_NE:
+            *result = (a != b);
+            return true;
+        case DILE_GT:
+            *result = (a > b);
+            return true;
+        case DILE_LT:
+            *result = (a < b);
+            return true;
+        case DILE_GE:
+            *result = (a >= b);
+            return true;
+        case DILE_LE:
+            *result = (a <= b);
+            return true;
+    }
+    return false;
+}
+
+/*
+ * Jump threading. A jump whose target is an unconditional GOTO is pointed
+ * straight at where that GOTO goes, so e.g. a 'break' at the end of an
+ * 'if' inside a loop no longer bounces through the GOTO that skips the
+ * 'else' branch. The GOTOs skipped are kept in the operand, see
+ * DIL_JUMP_SKIPPED, so a program is still charged for them. No code is
+ * moved, so labels, interrupts and 'on' tables keep their addresses.
+ *
+ * 'jump_adr' holds where the address operand of each IF and GOTO is stored.
+ * Returns the number of jumps threaded.
+ */
+int dil_thread_jumps(ubit8 *core, ubit32 corelen, const ubit32 *jump_adr, ubit32 jump_no)
+{
+    int threaded = 0;
+
+    if (corelen > DIL_JUMP_ADR(SKIP))
+    {
+        return 0; /* No room for the skipped GOTOs in the operand */
+    }
+
+    for (ubit32 i = 0; i < jump_no; i++)
+    {
+        ubit8 *rtmp = &core[jump_adr[i]];
+        ubit32 operand = bread_ubit32(&rtmp);
+        ubit32 target = DIL_JUMP_ADR(operand);
+        ubit32 skipped = DIL_JUMP_SKIPPED(operand);
+        int hops = 0;
+
+        while ((target < corelen) && (core[target] == DILI_GOTO))
+        {
+            rtmp = &core[target + 1];
+            ubit32 next = bread_ubit32(&rtmp);
+
+            /* The GOTO itself and any it skips in turn */
+            if (skipped + 1 + DIL_JUMP_SKIPPED(next) > DIL_JUMP_MAXSKIP)
+            {
+                break;
+            }
+            skipped += 1 + DIL_JUMP_SKIPPED(next);
+            target = DIL_JUMP_ADR(next);
+            hops++;
+        }
+
+        if (hops)
+        {
+            ubit8 *wtmp = &core[jump_adr[i]];
+            bwrite_ubit32(&wtmp, (skipped << 24) | target);
+            threaded++;
+        }
+    }
+
+    return threaded;
+}
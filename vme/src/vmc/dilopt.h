@@ -0,0 +1,6 @@
+#pragma once
+
+#include "essential.h"
+
+bool dil_fold_compare(int op, sbit32 a, sbit32 b, sbit32 *result);
+int dil_thread_jumps(ubit8 *core, ubit32 corelen, const ubit32 *jump_adr, ubit32 jump_no);
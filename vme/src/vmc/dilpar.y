@@ -21,6 +21,7 @@
 #define MPLEX_COMPILE 1
 #include "db_file.h"
 #include "dil.h"
+#include "dilopt.h"
 #include "dilpar.h"
 #include "dilshare.h"
 #include "intlist.h"
@@ -29,6 +30,8 @@
 #include "utils.h"
 extern char *diltext;
 extern bool g_quiet_compile;
+extern bool g_optimise_dil;
+extern bool g_dil_lines;
 int dillex(void);
 
 /*
@@ -69,6 +72,9 @@ ubit32 *label_use_idx;   /* what label is used (label_adr) */
 ubit32 *label_use_adr;   /* where a label is used */
 ubit32 labelgen;         /* counter for label generation */
 
+ubit32 jump_no;          /* number of jump addresses */
+ubit32 *jump_adr;        /* where a jump address is stored */
+
 ubit16 break_no;         /* size of break stack */
 ubit16 cont_no;          /* size of continue stack */
 ubit16 *break_idx;       /* break stack (label idx) */
@@ -111,7 +117,12 @@ void add_var(char *name, DilVarType_e type, const char *globalVarName);
 int add_label(char *str, ubit32 adr);
 ubit32 get_label(char *name, ubit32 adr);
 void moredilcore(ubit32 size);
+void mark_dilline(void);
 void update_labels(void);
+int fold_compare(int op, sbit32 a, sbit32 b);
+void add_jump(ubit32 adr);
+void optimise_jumps(void);
+int drop_dead_code(ubit32 from);
 void dilfatal(const char *str, ...);
 void dilwarning(const char *str);
 void dilsyntax(const char *str);
@@ -163,6 +174,8 @@ struct sSyms
         ubit32 fst, lst; /* first, last addr in core */
         ubit8 dsl, typ;  /* if expression: leftvalue, type */
         ubit8 boolean;
+        ubit8 constant;  /* coreexp: a static integer, in num */
+        sbit32 num;
     } ins;
     struct dilxref xref;
     struct sSyms *syms;
@@ -309,6 +322,7 @@ file    : program
                 }
                 //            dumpdiltemplate(&tmpl);
                 bwrite_diltemplate(pBuf, &tmpl);
+                bwrite_dillines(pBuf, &tmpl);
                 dil_free_template(&tmpl, 0, 1);
             }
         }
@@ -333,6 +347,11 @@ file    : program
         {
             FREE(label_adr);
         }
+        if (jump_no)
+        {
+            FREE(jump_adr);
+        }
+        jump_no = 0;
 
         label_no = 0;
 
@@ -354,11 +373,16 @@ program : DILSC_BEG dilinit diloptions fundef dilrefs dildecls DILSC_COD block D
         /* start at the top again */
         moredilcore(5);
         bwrite_ubit8(&wcore, DILI_GOTO);
+        add_jump(wcore - tmpl.core);
         bwrite_ubit32(&wcore, 0);
 
         /* truncate surplus core space */
         tmpl.coresz = wcore - tmpl.core + 1;
         update_labels();
+        if (g_optimise_dil)
+        {
+            optimise_jumps();
+        }
         tmpl.corecrc = dil_corecrc(tmpl.core, tmpl.coresz);
         prg.corecrc = tmpl.corecrc;
 
@@ -425,6 +449,8 @@ dilinit : /* nothing */
         tmpl.varcrc = 0;
         tmpl.corecrc = 0;
         tmpl.intrcount = 0;
+        tmpl.nLines = 0;
+        tmpl.lines = nullptr;
 
         wcore = tmpl.core;
 
@@ -466,6 +492,9 @@ dilinit : /* nothing */
         label_use_no = 0;
         label_use_adr = nullptr;
         label_use_idx = nullptr;
+        /* jump threading */
+        jump_no = 0;
+        jump_adr = nullptr;
         /* break and continue */
         break_no = 0;
         cont_no = 0;
@@ -2367,14 +2396,22 @@ dilexp  : dilsexp
             }
             break;
         }
-        /* Make nodes dynamic */
-        /* Integer compares are not _yet_ static */
-        make_code(&($1));
-        make_code(&($3));
-        add_code(&($$), &($1));
-        add_code(&($$), &($3));
-        add_ubit8(&($$), $2);
-        $$.dsl = DSL_DYN;
+        if (g_optimise_dil && ($1.typ == DilVarType_e::DILV_INT) && ($3.typ == DilVarType_e::DILV_INT) && !($1.dsl + $3.dsl))
+        {
+            /* Integer compare of two constants (vmc -O) */
+            $$.num = fold_compare($2, $1.num, $3.num);
+            $$.dsl = DSL_STA;
+        }
+        else
+        {
+            /* Make nodes dynamic */
+            make_code(&($1));
+            make_code(&($3));
+            add_code(&($$), &($1));
+            add_code(&($$), &($3));
+            add_ubit8(&($$), $2);
+            $$.dsl = DSL_DYN;
+        }
         $$.typ = DilVarType_e::DILV_INT;
         FREEEXP($1);
         FREEEXP($3);
@@ -2427,14 +2464,22 @@ dilexp  : dilsexp
             break;
         }
 
-        /* Make nodes dynamic */
-        /* Integer compares are not _yet_ static */
-        make_code(&($1));
-        make_code(&($3));
-        add_code(&($$), &($1));
-        add_code(&($$), &($3));
-        add_ubit8(&($$), $2);
-        $$.dsl = DSL_DYN;
+        if (g_optimise_dil && ($1.typ == DilVarType_e::DILV_INT) && ($3.typ == DilVarType_e::DILV_INT) && !($1.dsl + $3.dsl))
+        {
+            /* Integer compare of two constants (vmc -O) */
+            $$.num = fold_compare($2, $1.num, $3.num);
+            $$.dsl = DSL_STA;
+        }
+        else
+        {
+            /* Make nodes dynamic */
+            make_code(&($1));
+            make_code(&($3));
+            add_code(&($$), &($1));
+            add_code(&($$), &($3));
+            add_ubit8(&($$), $2);
+            $$.dsl = DSL_DYN;
+        }
         $$.typ = DilVarType_e::DILV_INT;
 
         FREEEXP($1);
@@ -2603,7 +2648,8 @@ dilsexp : dilterm
         {
             /* Type is INT + INT */
             $$.typ = DilVarType_e::DILV_INT;
-            if (!($1.dsl + $3.typ))
+            /* Historically never folded, vmc -O folds it like '-' */
+            if (g_optimise_dil ? !($1.dsl + $3.dsl) : !($1.dsl + $3.typ))
             {
                 $$.num = $1.num + $3.num;
                 $$.dsl = DSL_STA;
@@ -5408,9 +5454,12 @@ coreexp   : dilexp
             dilfatal("Illegal use of proc/func");
         }
 
+        $$.constant = ($1.dsl == DSL_STA) && ($1.typ == DilVarType_e::DILV_INT);
+        $$.num = $1.num;
         make_code(&($1));
         $$.boolean = $1.boolean;
         /* write dynamic expression in core */
+        mark_dilline();
         $$.fst = wcore - tmpl.core;
         moredilcore($1.codep - $1.code);
         for (i = 0; i < $1.codep - $1.code; i++, wcore++)
@@ -5441,6 +5490,7 @@ corevar   : variable
         make_code(&($1)); /* does nothing!? */
         $$.boolean = $1.boolean;
         /* write dynamic expression in core */
+        mark_dilline();
         $$.fst = wcore - tmpl.core;
         moredilcore($1.codep - $1.code);
         for (i = 0; i < $1.codep - $1.code; i++, wcore++)
@@ -5464,6 +5514,7 @@ corevar   : variable
 
 ihold   : /* instruction core placeholder */
     {
+        mark_dilline();
         $$ = wcore - tmpl.core;
         wcore++; /* ubit8 */
     }
@@ -5479,6 +5530,7 @@ ahold   : /* address core placeholder */
 label   : SYMBOL
     {
         /* lable reference */
+        mark_dilline();
         $$.fst = wcore - tmpl.core;
         moredilcore(4);
         bwrite_ubit32(&wcore, get_label($1, wcore - tmpl.core)); /* here */
@@ -6800,38 +6852,61 @@ dilcomposed   : '{' dilinstlist '}' optsemicolons
 
 dilcomplex : DILSI_IF '(' coreexp ')' ihold ahold block ihold ahold DILSI_ELS dilcomposed
     {
+        ubit32 end = $11.lst;
+
+        if (g_optimise_dil && $3.constant && $3.num && drop_dead_code($9 + 4))
+        {
+            end = $9 + 4; /* the else branch can never run (vmc -O) */
+        }
         wtmp = &tmpl.core[$5];
         bwrite_ubit8(&wtmp, DILI_IF); /* the instruction */
         wtmp = &tmpl.core[$6];
-        bwrite_ubit32(&wtmp, $11.fst); /* address of else */
+        bwrite_ubit32(&wtmp, $9 + 4); /* address of else */
         wtmp = &tmpl.core[$8];
         bwrite_ubit8(&wtmp, DILI_GOTO); /* skip else */
         wtmp = &tmpl.core[$9];
-        bwrite_ubit32(&wtmp, $11.lst); /* end of else */
+        bwrite_ubit32(&wtmp, end); /* end of else */
+        add_jump($6);
+        add_jump($9);
         $$.fst = $3.fst;
-        $$.lst = $11.lst;
+        $$.lst = end;
     }
     | DILSI_IF '(' coreexp ')' ihold ahold dilinst optsemicolons ihold ahold DILSI_ELS dilcomposed
     {
+        ubit32 end = $12.lst;
+
+        if (g_optimise_dil && $3.constant && $3.num && drop_dead_code($10 + 4))
+        {
+            end = $10 + 4; /* the else branch can never run (vmc -O) */
+        }
         wtmp = &tmpl.core[$5];
         bwrite_ubit8(&wtmp, DILI_IF); /* the instruction */
         wtmp = &tmpl.core[$6];
-        bwrite_ubit32(&wtmp, $12.fst); /* address of else */
+        bwrite_ubit32(&wtmp, $10 + 4); /* address of else */
         wtmp = &tmpl.core[$9];
         bwrite_ubit8(&wtmp, DILI_GOTO); /* skip else */
         wtmp = &tmpl.core[$10];
-        bwrite_ubit32(&wtmp, $12.lst); /* end of else */
+        bwrite_ubit32(&wtmp, end); /* end of else */
+        add_jump($6);
+        add_jump($10);
         $$.fst = $3.fst;
-        $$.lst = $12.lst;
+        $$.lst = end;
     }
     | DILSI_IF '(' coreexp ')' ihold ahold dilcomposed
     {
+        ubit32 end = $7.lst;
+
+        if (g_optimise_dil && $3.constant && !$3.num && drop_dead_code($6 + 4))
+        {
+            end = $6 + 4; /* the branch can never run (vmc -O) */
+        }
         wtmp = &tmpl.core[$5];
         bwrite_ubit8(&wtmp, DILI_IF); /* the instruction */
         wtmp = &tmpl.core[$6];
-        bwrite_ubit32(&wtmp, $7.lst); /* address of else */
+        bwrite_ubit32(&wtmp, end); /* address of else */
+        add_jump($6);
         $$.fst = $3.fst;
-        $$.lst = $7.lst;
+        $$.lst = end;
     }
     | DILSI_FOE '(' coreexp ',' ihold pushbrk pushcnt defcnt corevar ihold ahold ')'
     {
@@ -6864,6 +6939,7 @@ dilcomplex : DILSI_IF '(' coreexp ')' ihold ahold block ihold ahold DILSI_ELS di
         wtmp = &tmpl.core[$16];
         bwrite_ubit8(&wtmp, DILI_GOTO); /* loop */
         bwrite_ubit32(&wtmp, $9.fst);
+        add_jump($16 + 1);
         $$.fst = $3.fst;
         $$.lst = wcore - tmpl.core;
     }
@@ -6884,6 +6960,8 @@ dilcomplex : DILSI_IF '(' coreexp ')' ihold ahold block ihold ahold DILSI_ELS di
         bwrite_ubit8(&wtmp, DILI_GOTO); /* test again */
         wtmp = &tmpl.core[$12];
         bwrite_ubit32(&wtmp, $6.fst); /* address of start */
+        add_jump($9);
+        add_jump($12);
         $$.fst = $6.fst;
         $$.lst = wcore - tmpl.core;
     }
@@ -7054,6 +7132,7 @@ corefuncall   : funcall
         make_code(&($1));
         $$.boolean = $1.boolean;
         /* write dynamic expression in core */
+        mark_dilline();
         $$.fst = wcore - tmpl.core;
         moredilcore($1.codep - $1.code);
         for (i = 0; i < $1.codep - $1.code; i++, wcore++)
@@ -7246,6 +7325,7 @@ dilinst  : dilproc
     {
         wtmp = &tmpl.core[$2];
         bwrite_ubit8(&wtmp, DILI_GOTO);
+        add_jump($3.fst);
         $$.fst = $2;
         $$.lst = $3.lst;
     }
@@ -7264,6 +7344,7 @@ dilinst  : dilproc
             wtmp = &tmpl.core[$3];
             /* register use or find break label */
             bwrite_ubit32(&wtmp, get_label(label_names[break_idx[break_no - 1]], $3));
+            add_jump($3);
         }
         $$.fst = $2;
         $$.lst = $3 + 4;
@@ -7283,6 +7364,7 @@ dilinst  : dilproc
             wtmp = &tmpl.core[$3];
             /* register use or find continue label */
             bwrite_ubit32(&wtmp, get_label(label_names[cont_idx[break_no - 1]], $3));
+            add_jump($3);
         }
         $$.fst = $2;
         $$.lst = $3 + 4;
@@ -7419,6 +7501,101 @@ void update_labels(void)
     }
 }
 
+/*
+ * Fold an integer compare of two constants (vmc -O).
+ */
+int fold_compare(int op, sbit32 a, sbit32 b)
+{
+    sbit32 result = 0;
+
+    if (!dil_fold_compare(op, a, b, &result))
+    {
+        dilfatal("Internal compiler error folding compare %d.", op);
+    }
+    return result;
+}
+
+/*
+ * Remember where the address operand of an IF or GOTO is
+ * stored, so optimise_jumps() can thread it later.
+ */
+void add_jump(ubit32 adr)
+{
+    if (jump_no == 0)
+    {
+        CREATE(jump_adr, ubit32, 1);
+    }
+    else
+    {
+        RECREATE(jump_adr, ubit32, jump_no + 1);
+    }
+    jump_adr[jump_no++] = adr;
+}
+
+/*
+ * Jump threading (vmc -O), see dil_thread_jumps().
+ */
+void optimise_jumps(void)
+{
+    dil_thread_jumps(tmpl.core, wcore - tmpl.core, jump_adr, jump_no);
+}
+
+/*
+ * Dead code elimination (vmc -O). Drop the code from 'from' to the end of
+ * the core written so far, a branch of an 'if' on a constant that can never
+ * run. The labels used and the jumps made from there are forgotten. Refused
+ * if a label the rest of the program could jump to is defined there.
+ * Returns TRUE if the code was dropped.
+ */
+int drop_dead_code(ubit32 from)
+{
+    ubit32 end = wcore - tmpl.core;
+    ubit32 i;
+    ubit32 n;
+
+    for (i = 0; i < label_no; i++)
+    {
+        /* Break and continue labels ("__") are only used from inside */
+        if ((label_adr[i] != SKIP) && (label_adr[i] >= from) && (label_adr[i] <= end) && strncmp(label_names[i], "__", 2))
+        {
+            return FALSE;
+        }
+    }
+
+    for (i = 0; i < label_use_no; i++)
+    {
+        if ((label_use_adr[i] != SKIP) && (label_use_adr[i] >= from))
+        {
+            label_use_adr[i] = SKIP;
+        }
+    }
+
+    for (i = n = 0; i < jump_no; i++)
+    {
+        if (jump_adr[i] < from)
+        {
+            jump_adr[n++] = jump_adr[i];
+        }
+    }
+    jump_no = n;
+    if ((jump_no == 0) && jump_adr)
+    {
+        FREE(jump_adr);
+    }
+
+    while ((tmpl.nLines > 0) && (tmpl.lines[2 * (tmpl.nLines - 1)] >= from))
+    {
+        tmpl.nLines--;
+    }
+    if ((tmpl.nLines == 0) && tmpl.lines)
+    {
+        FREE(tmpl.lines);
+    }
+
+    wcore = tmpl.core + from;
+    return TRUE;
+}
+
 void dilsyntax(const char *str)
 {
     fprintf(stderr, "D:\n%d: %s\n    Token: '%s'\n", dillinenum, str, diltext);
@@ -7473,6 +7650,49 @@ void moredilcore(ubit32 size)
     }
 }
 
+/*
+ * Source line table (vmc -g). Remember the line the code written from
+ * here on comes from, one entry per change of line, so the profiler in
+ * the server can attribute a sampled core offset to a line. Only
+ * templates carry a table, inline programs are left without.
+ */
+void mark_dilline(void)
+{
+    ubit32 pc = wcore - tmpl.core;
+
+    if (!g_dil_lines || !dilistemplate)
+    {
+        return;
+    }
+
+    if (tmpl.nLines > 0)
+    {
+        ubit32 *last = &tmpl.lines[2 * (tmpl.nLines - 1)];
+
+        if (last[1] == (ubit32)dillinenum)
+        {
+            return;
+        }
+        if (last[0] == pc)
+        {
+            last[1] = dillinenum; /* nothing written for the previous line */
+            return;
+        }
+    }
+
+    if (tmpl.nLines == 0)
+    {
+        CREATE(tmpl.lines, ubit32, 2);
+    }
+    else
+    {
+        RECREATE(tmpl.lines, ubit32, 2 * (tmpl.nLines + 1));
+    }
+    tmpl.lines[2 * tmpl.nLines] = pc;
+    tmpl.lines[2 * tmpl.nLines + 1] = dillinenum;
+    tmpl.nLines++;
+}
+
 /* expression manipulation */
 
 void add_ubit8(struct exptype *dest, ubit8 d)
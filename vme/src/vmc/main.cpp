@@ -105,6 +105,22 @@ int main(int argc, char **argv)
                     }
                     break;
 
+                case 'M':
+                    if (*(argv[pos] + 2))
+                    {
+                        g_depfile = argv[pos] + 2;
+                    }
+                    else if (++pos < argc)
+                    {
+                        g_depfile = argv[pos];
+                    }
+                    else
+                    {
+                        slog(LOG_OFF, 0, "Name of the depfile expected.");
+                        exit(1);
+                    }
+                    break;
+
                 case 'q':
                     g_quiet_compile = true;
                     break;
@@ -113,6 +129,14 @@ int main(int argc, char **argv)
                     g_dump_json = true;
                     break;
 
+                case 'O':
+                    g_optimise_dil = true;
+                    break;
+
+                case 'g':
+                    g_dil_lines = true;
+                    break;
+
                 case '?':
                     ShowUsage(argv[0]);
                     exit(0);
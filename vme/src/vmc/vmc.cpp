@@ -10,6 +10,7 @@
 #include "common.h"
 #include "db_file.h"
 #include "dil.h"
+#include "dilstring.h"
 #include "error.h"
 #include "pp.h"
 #include "unit_affected_type.h"
@@ -23,6 +24,7 @@
 #include <utils.h>
 
 #include <algorithm>
+#include <climits>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
@@ -45,6 +47,7 @@ void dump_zone(char *prefix);
 void dump_json_zone(char *prefix);
 void write_diltemplate_json(rapidjson::PrettyWriter<rapidjson::StringBuffer> &writer, diltemplate *tmpl);
 long stat_mtime(char *name);
+void write_depfile(const char *prefix);
 void dil_free_template(diltemplate *tmpl, int copy, int dil = FALSE);
 void dil_free_var(dilvar *var);
 void dil_free_frame(dilframe *frame);
@@ -59,6 +62,9 @@ int g_verbose = 0;        /* be talkative */
 int g_fatal_warnings = 0; /* allow warnings */
 bool g_quiet_compile = false;
 bool g_dump_json = false;
+const char *g_depfile = nullptr; /* write #include dependencies here */
+bool g_optimise_dil = false;     /* run the DIL bytecode optimiser */
+bool g_dil_lines = false;        /* emit DIL source line tables */
 
 char **ident_names = nullptr; /* Used to check unique ident */
 
@@ -76,7 +82,7 @@ int inc_count = 0;
 
 void ShowUsage(char *name)
 {
-    fprintf(stderr, "Usage: %s [-msvlh] [-Idir ..] zonefile ...\n", name);
+    fprintf(stderr, "Usage: %s [-msvlhOg] [-Idir ..] [-M depfile] zonefile ...\n", name);
     fprintf(stderr, "   -m Compile only changed zones.\n");
     fprintf(stderr, "   -s Suppress output of data files.\n");
     fprintf(stderr, "   -v Verbose mode.\n");
@@ -87,6 +93,9 @@ void ShowUsage(char *name)
     fprintf(stderr, "   -p preprocess file only, output to stdout.\n");
     fprintf(stderr, "   -q Quiet compile.\n");
     fprintf(stderr, "   -j Dump JSON.\n");
+    fprintf(stderr, "   -M Write a Make style depfile of all included files.\n");
+    fprintf(stderr, "   -O Optimise DIL bytecode (fold constants, thread jumps).\n");
+    fprintf(stderr, "   -g Emit DIL source line tables for the profiler.\n");
     fprintf(stderr, "Copyright 1994 - 2001 (C) by Valhalla.\n");
 }
 
@@ -197,6 +206,10 @@ void fix(char *file)
             dump_json_zone(filename_prefix);
         }
         dump_zone(filename_prefix);
+        if (g_depfile)
+        {
+            write_depfile(filename_prefix);
+        }
     }
 }
 
@@ -587,6 +600,34 @@ void dump_zone(char *prefix)
     fclose(fl);
 }
 
+/*
+ * Write the files read by the preprocessor as dependencies of the
+ * .data and .reset files, so a build system can recompile a zone
+ * exactly when one of the files it includes changes.
+ */
+void write_depfile(const char *prefix)
+{
+    std::string path;
+
+    if (*prefix != '/')
+    {
+        char cwd[PATH_MAX];
+        if (getcwd(cwd, sizeof(cwd)))
+        {
+            path = std::string(cwd) + "/";
+        }
+    }
+    path += prefix;
+
+    std::string targets = path + "." OUTPUT_WSUFFIX " " + path + "." OUTPUT_RSUFFIX;
+
+    if (!depend_write(g_depfile, targets.c_str()))
+    {
+        fprintf(stderr, "Unable to write depfile '%s'.\n", g_depfile);
+        exit(1);
+    }
+}
+
 long stat_mtime(char *name)
 {
     struct stat buf;
@@ -635,7 +676,7 @@ void dil_free_var(dilvar *v)
         case DilVarType_e::DILV_SP:
             if (v->val.string)
             {
-                FREE(v->val.string);
+                dilstr_free(v->val.string);
                 v->val.string = nullptr;
             }
             break;
@@ -717,6 +758,9 @@ void dil_free_template(diltemplate *tmpl, int copy, int dil)
         if (tmpl->core)
             FREE(tmpl->core);
 
+        if (tmpl->lines)
+            FREE(tmpl->lines);
+
         if (tmpl->extprg)
             FREE(tmpl->extprg);
 
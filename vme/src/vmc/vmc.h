@@ -102,3 +102,6 @@ extern int g_nooutput;
 extern int g_make;
 extern bool g_quiet_compile;
 extern bool g_dump_json;
+extern const char *g_depfile;
+extern bool g_optimise_dil;
+extern bool g_dil_lines;
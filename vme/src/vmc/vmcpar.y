@@ -193,6 +193,7 @@ dil     : DILPRG
         char buf[255];
 
         cur_tmpl = bread_diltemplate(vpBuf, UNIT_VERSION);
+        bread_dillines(vpBuf, cur_tmpl);
 
         assert(vpBuf->GetReadPosition() == vpBuf->GetLength());
         // Comment out
@@ -581,6 +582,7 @@ unit_field  : NAMES stringlist
         char buf[255];
 
         cur_tmpl = bread_diltemplate(vpBuf, UNIT_VERSION);
+        bread_dillines(vpBuf, cur_tmpl);
 
         assert(vpBuf->GetReadPosition() == vpBuf->GetLength());
         // Comment out
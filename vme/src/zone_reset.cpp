@@ -18,6 +18,8 @@
 #include "utils.h"
 #include "zone_reset_cmd.h"
 
+#include <sys/time.h>
+
 zone_type *g_boot_zone = nullptr; /* Points to the zone currently booted */
 
 /* No Operation */
@@ -42,35 +44,6 @@ unit_data *zone_random(unit_data *u, zone_reset_cmd *cmd)
     }
 }
 
-/* Count ->no_in_zone for current 'g_boot_zone' (above) */
-void zone_update_no_in_zone()
-{
-    unit_data *u = nullptr;
-
-    /* Clear ALL ->no_in_zone */
-    for (auto tmp_zone = g_zone_info.mmp.begin(); tmp_zone != g_zone_info.mmp.end(); tmp_zone++)
-    {
-        tmp_zone->second->updateNumberInZone();
-    }
-
-    for (u = g_unit_list; u; u = u->getGlobalNext())
-    {
-        if (u->getFileIndex() && (unit_zone(u) == g_boot_zone))
-        {
-            u->getFileIndex()->IncrementNumInZone();
-        }
-    }
-}
-
-/* After loading a unit, call this function to update no_in_zone */
-void zone_loaded_a_unit(unit_data *u)
-{
-    if (unit_zone(u) == g_boot_zone)
-    {
-        u->getFileIndex()->IncrementNumInZone();
-    }
-}
-
 /* num[0] is the max allowed existing in world              */
 /* num[1] is the max allowed existing in zone.              */
 /* num[2] is the max allowed existing in room (object)      */
@@ -104,7 +77,7 @@ bool zone_limit(unit_data *u, file_index_type *fi, zone_reset_cmd *cmd)
     }
 
     /* Check for zone maximum */
-    if (cmd->getNum(1) && fi->getNumInZone() >= cmd->getNum(1) && unit_zone(u) == g_boot_zone)
+    if (cmd->getNum(1) && fi->getNumInZone(g_boot_zone) >= cmd->getNum(1) && unit_zone(u) == g_boot_zone)
     {
         return FALSE;
     }
@@ -171,7 +144,6 @@ unit_data *zone_load(unit_data *u, zone_reset_cmd *cmd)
             {
                 unit_to_unit(loaded, u);
             }
-            zone_loaded_a_unit(loaded);
             dil_loadtime_activate(loaded);
             if (loaded->isChar())
             {
@@ -230,7 +202,6 @@ unit_data *zone_equip(unit_data *u, zone_reset_cmd *cmd)
         loaded = read_unit(cmd->getFileIndexType(0));
 
         unit_to_unit(loaded, u);
-        zone_loaded_a_unit(loaded);
         if (loaded)
         {
             dil_loadtime_activate(loaded);
@@ -363,7 +334,6 @@ unit_data *zone_follow(unit_data *u, zone_reset_cmd *cmd)
 
         unit_to_unit(loaded, u->getUnitIn());
         start_following(loaded, u);
-        zone_loaded_a_unit(loaded);
 
         act("$1n has arrived.", eA_HIDEINV, loaded, cActParameter(), cActParameter(), eTO_ROOM);
         if (loaded)
@@ -378,21 +348,29 @@ unit_data *zone_follow(unit_data *u, zone_reset_cmd *cmd)
 unit_data *(*exec_zone_cmd[])(unit_data *, zone_reset_cmd *) =
     {zone_nop, zone_load, zone_equip, zone_door, zone_purge, zone_remove, zone_follow, zone_random};
 
+bool low_reset_zone(unit_data *u, zone_reset_cmd *cmd);
+
+/* Execute a single command and the commands nested under it */
+static unit_data *reset_one_cmd(unit_data *u, zone_reset_cmd *cmd)
+{
+    unit_data *success = (*exec_zone_cmd[cmd->getCommandNum()])(u, cmd);
+
+    if (success && cmd->getNested() && !low_reset_zone(success, cmd->getNested()) && cmd->getCompleteFlag())
+    {
+        extract_unit(success);
+        success = nullptr;
+    }
+
+    return success;
+}
+
 bool low_reset_zone(unit_data *u, zone_reset_cmd *cmd)
 {
-    unit_data *success = nullptr;
     bool ok = TRUE;
 
     for (; cmd; cmd = cmd->getNext())
     {
-        success = (*exec_zone_cmd[cmd->getCommandNum()])(u, cmd);
-        if (success && cmd->getNested() && !low_reset_zone(success, cmd->getNested()) && cmd->getCompleteFlag())
-        {
-            extract_unit(success);
-            success = nullptr;
-        }
-
-        ok = ok && success;
+        ok = reset_one_cmd(u, cmd) && ok;
     }
     return ok;
 }
@@ -403,9 +381,8 @@ void zone_reset(zone_type *zone)
            int i = memory_total_alloc; */
     g_boot_zone = zone;
 
-    zone_update_no_in_zone(); /* Reset the fi->no_in_zone */
-
     low_reset_zone(nullptr, zone->getZoneResetCommands());
+    zone->setZoneResetNext(nullptr); /* Anything left of a sliced reset is done now */
 
     /* Far too much LOG:
        slog(LOG_OFF, 0, "Zone reset of '%s' done (%d bytes used).",
@@ -414,65 +391,97 @@ void zone_reset(zone_type *zone)
     g_boot_zone = nullptr;
 }
 
-/* MS: Changed this to queue reset events at boot such that game comes up
-   really fast */
+/* Microseconds per tic all zone resets together may spend before the
+   rest of a reset is left for the next tic. */
+#define ZONE_RESET_TIC_BUDGET 5000
 
-/* Changed back to boot all before players login */
-void reset_all_zones()
+static int reset_budget_tic = -1;  /* The tic the budget below belongs to */
+static long reset_budget_left = 0; /* Microseconds left in that tic       */
+
+/* Run the top level reset commands of zone from cmd on until they are all
+   done or the budget of this tic is spent. A top level command always runs
+   together with everything nested under it, so a slice never stops with
+   loaded units waiting for their nested commands. At least one command is
+   run per call so a reset always makes progress.
+   Returns the command to continue from, or nullptr when the reset is done. */
+static zone_reset_cmd *zone_reset_slice(zone_type *zone, zone_reset_cmd *cmd)
 {
-    int j = 0;
+    timeval start;
+    timeval now;
 
-    for (j = 0; j <= 255; j++)
+    if (reset_budget_tic != g_tics)
     {
-        for (auto zone = g_zone_info.mmp.begin(); zone != g_zone_info.mmp.end(); zone++)
-        {
-            if (j == 0)
-            {
-                zone_info_type::g_world_nozones++;
-            }
+        reset_budget_tic = g_tics;
+        reset_budget_left = ZONE_RESET_TIC_BUDGET;
+    }
 
-            if (zone->second->getAccessLevel() != j)
-            {
-                continue;
-            }
+    g_boot_zone = zone;
 
-            if (zone->second->getZoneResetTime() > 0)
-            {
-                zone_event((void *)zone->second, (void *)nullptr);
-            }
+    while (cmd)
+    {
+        gettimeofday(&start, nullptr);
+        reset_one_cmd(nullptr, cmd);
+        cmd = cmd->getNext();
+        gettimeofday(&now, nullptr);
+
+        reset_budget_left -= (now.tv_sec - start.tv_sec) * 1000000L + (now.tv_usec - start.tv_usec);
+        if (reset_budget_left <= 0)
+        {
+            break;
         }
     }
+
+    g_boot_zone = nullptr;
+
+    return cmd;
 }
 
-bool zone_is_empty(zone_type *zone)
+/* Continue a reset spread over several tics */
+void zone_reset_event(void *p1, void *p2)
 {
-    descriptor_data *d = nullptr;
+    zone_type *zone = (zone_type *)p1;
 
-    for (d = g_descriptor_list; d; d = d->getNext())
+    if (zone->getZoneResetNext() == nullptr)
     {
-        if (descriptor_is_playing(d))
-        {
-            if (unit_zone(d->cgetCharacter()) == zone)
-            {
-                return FALSE;
-            }
-        }
+        return; /* Finished by a complete zone_reset() meanwhile */
     }
 
-    return TRUE;
+    zone->setZoneResetNext(zone_reset_slice(zone, zone->getZoneResetNext()));
+
+    if (zone->getZoneResetNext())
+    {
+        g_events.add(1, zone_reset_event, zone, nullptr);
+    }
 }
 
-/* Check if the zone pointed to by *p1 is due for a zone reset */
-void zone_event(void *p1, void *p2)
+bool zone_is_empty(zone_type *zone)
 {
-    zone_type *zone = (zone_type *)p1;
+    return zone->getNumOfPlayers() == 0;
+}
 
+/* Reset the zone if it is due and queue the next check. At boot the reset
+   is run to completion, later it is sliced over as many tics as needed. */
+static void zone_reset_due(zone_type *zone, bool sliced)
+{
     if (zone->getResetMode() == RESET_NEVER)
         return;
 
-    if (zone->getResetMode() != RESET_IFEMPTY || zone_is_empty(zone))
+    if (zone->getZoneResetNext())
     {
-        zone_reset(zone);
+        /* The previous reset hasn't finished yet */
+        g_events.add(1 * PULSE_ZONE, zone_event, zone, nullptr);
+    }
+    else if (zone->getResetMode() != RESET_IFEMPTY || zone_is_empty(zone))
+    {
+        if (sliced)
+        {
+            zone->setZoneResetNext(zone->getZoneResetCommands());
+            zone_reset_event(zone, nullptr);
+        }
+        else
+        {
+            zone_reset(zone);
+        }
 
         /* Papi: Did a little random boogie to prevent reset all at the
          *       same time (causes lags!)
@@ -488,3 +497,39 @@ void zone_event(void *p1, void *p2)
         g_events.add(1 * PULSE_ZONE, zone_event, zone, nullptr);
     }
 }
+
+/* Check if the zone pointed to by *p1 is due for a zone reset */
+void zone_event(void *p1, void *p2)
+{
+    zone_reset_due((zone_type *)p1, true);
+}
+
+/* MS: Changed this to queue reset events at boot such that game comes up
+   really fast */
+
+/* Changed back to boot all before players login */
+void reset_all_zones()
+{
+    int j = 0;
+
+    for (j = 0; j <= 255; j++)
+    {
+        for (auto zone = g_zone_info.mmp.begin(); zone != g_zone_info.mmp.end(); zone++)
+        {
+            if (j == 0)
+            {
+                zone_info_type::g_world_nozones++;
+            }
+
+            if (zone->second->getAccessLevel() != j)
+            {
+                continue;
+            }
+
+            if (zone->second->getZoneResetTime() > 0)
+            {
+                zone_reset_due(zone->second, false);
+            }
+        }
+    }
+}
@@ -5,5 +5,6 @@
 void zone_reset(zone_type *zone);
 void reset_all_zones();
 void zone_event(void *, void *);
+void zone_reset_event(void *, void *);
 
 extern zone_type *g_boot_zone;
@@ -89,4 +89,16 @@ void zone_reset_cmd::toJSON(rapidjson::PrettyWriter<rapidjson::StringBuffer> &wr
         json::write_pointer_kvp("nested", nested, writer);
     }
     writer.EndObject();
-}
\ No newline at end of file
+}
+
+void free_zone_reset(zone_reset_cmd *cmd)
+{
+    zone_reset_cmd *next = nullptr;
+
+    for (; cmd; cmd = next)
+    {
+        next = cmd->getNext();
+        free_zone_reset(cmd->getNested());
+        delete cmd;
+    }
+}
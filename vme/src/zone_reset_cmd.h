@@ -44,3 +44,8 @@ private:
     zone_reset_cmd *next{nullptr};         ///<
     zone_reset_cmd *nested{nullptr};       ///<
 };
+
+/**
+ * Delete 'cmd', the commands following it and all their nested commands
+ */
+void free_zone_reset(zone_reset_cmd *cmd);
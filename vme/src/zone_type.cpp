@@ -2,6 +2,7 @@
 
 #include "db.h"
 #include "dil.h"
+#include "dilprofile.h"
 #include "file_index_type.h"
 #include "formatter.h"
 #include "json_helper.h"
@@ -10,6 +11,67 @@
 #include "unit_data.h"
 #include "zone_reset_cmd.h"
 
+#include <algorithm>
+#include <set>
+
+static void free_template_data(diltemplate *pt)
+{
+    if (pt->prgname)
+    {
+        FREE(pt->prgname);
+    }
+    if (pt->argt)
+    {
+        FREE(pt->argt);
+    }
+    if (pt->core)
+    {
+        FREE(pt->core);
+    }
+    if (pt->vart)
+    {
+        FREE(pt->vart);
+    }
+    if (pt->lines)
+    {
+        FREE(pt->lines);
+    }
+    if (pt->lineSamples)
+    {
+        FREE(pt->lineSamples);
+    }
+    if (pt->varg)
+    {
+        for (int i = 0; i < pt->varc; i++)
+        {
+            if (pt->varg[i])
+            {
+                FREE(pt->varg[i]);
+            }
+        }
+        FREE(pt->varg);
+    }
+    if (pt->extprg)
+    {
+        FREE(pt->extprg);
+    }
+    if (pt->xrefs)
+    {
+        for (int i = 0; i < pt->xrefcount; i++)
+        {
+            if (pt->xrefs[i].name)
+            {
+                FREE(pt->xrefs[i].name);
+            }
+            if (pt->xrefs[i].argt)
+            {
+                FREE(pt->xrefs[i].argt);
+            }
+        }
+        FREE(pt->xrefs);
+    }
+}
+
 zone_type::zone_type(std::string name)
     : m_name(std::move(name))
 {
@@ -39,33 +101,16 @@ zone_type::~zone_type()
         delete ut;
     }
 
-    zone_reset_cmd *pzri = nullptr;
-    zone_reset_cmd *nextzri = nullptr;
+    free_zone_reset(m_zri);
 
-    for (pzri = m_zri; pzri; pzri = nextzri)
+    for (auto &[name, pt] : m_mmp_tmpl)
     {
-        nextzri = pzri->getNext();
-        DELETE(zone_reset_cmd, pzri);
+        free_template_data(pt.get());
     }
 
-    for (auto &[name, pt] : m_mmp_tmpl)
+    for (auto &pt : m_retired_tmpl)
     {
-        if (pt->prgname)
-        {
-            FREE(pt->prgname);
-        }
-        if (pt->argt)
-        {
-            FREE(pt->argt);
-        }
-        if (pt->core)
-        {
-            FREE(pt->core);
-        }
-        if (pt->vart)
-        {
-            FREE(pt->vart);
-        }
+        free_template_data(pt.get());
     }
 
     // struct bin_search_type *ba;    /* Pointer to binarray of type      */
@@ -144,8 +189,22 @@ zone_reset_cmd *zone_type::getZoneResetCommands()
 
 void zone_type::setZoneResetCommands(zone_reset_cmd *value)
 {
-    DELETE(zone_reset_cmd, m_zri);
+    if (value != m_zri)
+    {
+        free_zone_reset(m_zri);
+    }
     m_zri = value;
+    m_zri_next = nullptr;
+}
+
+zone_reset_cmd *zone_type::getZoneResetNext() const
+{
+    return m_zri_next;
+}
+
+void zone_type::setZoneResetNext(zone_reset_cmd *value)
+{
+    m_zri_next = value;
 }
 
 size_t zone_type::getNumOfFileIndexes() const
@@ -168,6 +227,11 @@ ubit32 zone_type::getCrc() const
     return m_crc;
 }
 
+void zone_type::clearCrc()
+{
+    m_crc = 0;
+}
+
 void zone_type::setCrc(ubit32 crc)
 {
     if (m_crc == 0)
@@ -223,6 +287,21 @@ ubit16 zone_type::getNumOfNPCs() const
     return m_no_npcs;
 }
 
+ubit16 zone_type::getNumOfPlayers() const
+{
+    return m_no_players;
+}
+
+void zone_type::incrementNumOfPlayers()
+{
+    ++m_no_players;
+}
+
+void zone_type::decrementNumOfPlayers()
+{
+    --m_no_players;
+}
+
 ubit8 zone_type::getResetMode() const
 {
     return m_reset_mode;
@@ -391,14 +470,6 @@ file_index_type *zone_type::findOrCreatePlayerFileIndex(const char *name)
     return result.first->second.get();
 }
 
-void zone_type::updateNumberInZone()
-{
-    for (auto &[name, fi] : m_mmp_fi)
-    {
-        fi->setNumInZone(0);
-    }
-}
-
 void zone_type::insertFileIndex(std::unique_ptr<file_index_type> &&value)
 {
     m_mmp_fi.insert(std::make_pair(value->getName(), std::move(value)));
@@ -413,6 +484,58 @@ file_index_type *zone_type::findFileIndex(const std::string &name)
     return nullptr;
 }
 
+std::string zone_type::checkFileIndexes(const std::vector<std::unique_ptr<file_index_type>> &indexes) const
+{
+    for (auto &fi : indexes)
+    {
+        auto it = m_mmp_fi.find(fi->getName());
+
+        if (it != m_mmp_fi.end() && it->second->getType() != fi->getType())
+        {
+            return diku::format_to_str("%s changed unit type, that needs a reboot.", fi->getName());
+        }
+    }
+    return "";
+}
+
+void zone_type::reindexFileIndexes(std::vector<std::unique_ptr<file_index_type>> &&indexes)
+{
+    std::set<std::string> seen;
+
+    for (auto &fi : indexes)
+    {
+        auto it = m_mmp_fi.find(fi->getName());
+
+        if (it == m_mmp_fi.end())
+        {
+            if (fi->getType() == UNIT_ST_ROOM)
+            {
+                szonelog(this, "Reload: new room %s needs a reboot.", fi->getName());
+                continue;
+            }
+            seen.insert(fi->getName());
+            insertFileIndex(std::move(fi));
+            continue;
+        }
+
+        file_index_type *old = it->second.get();
+        assert(old->getType() == fi->getType());
+
+        old->setFilepos(fi->getFilepos());
+        old->setLength(fi->getLength());
+        old->setCRC(fi->getCRC());
+        seen.insert(old->getName());
+    }
+
+    for (auto &[name, fi] : m_mmp_fi)
+    {
+        if (fi->getType() != UNIT_ST_ROOM && seen.find(name) == seen.end())
+        {
+            fi->setLength(0);
+        }
+    }
+}
+
 std::string zone_type::getStatDIL() const
 {
     std::string msg;
@@ -471,6 +594,174 @@ void zone_type::getStatGlobalDILJSON(ubit32 nCount, ubit64 &instructionSum, rapi
     writer.EndArray();
 }
 
+zone_type::DILProfileLines zone_type::getDILProfileLines() const
+{
+    std::vector<const diltemplate *> templates;
+    for (auto &[name, dil_template] : m_mmp_tmpl)
+    {
+        templates.push_back(dil_template.get());
+    }
+    for (auto &dil_template : m_retired_tmpl)
+    {
+        templates.push_back(dil_template.get());
+    }
+
+    std::map<std::pair<std::string, ubit32>, ubit32> lines;
+    for (auto *tmpl : templates)
+    {
+        ubit32 unattributed = tmpl->nSamples;
+
+        for (ubit32 i = 0; i < tmpl->nLines && tmpl->lineSamples; i++)
+        {
+            if (tmpl->lineSamples[i])
+            {
+                lines[{tmpl->prgname, tmpl->lines[2 * i + 1]}] += tmpl->lineSamples[i];
+                unattributed -= tmpl->lineSamples[i];
+            }
+        }
+        if (unattributed)
+        {
+            lines[{tmpl->prgname, 0}] += unattributed;
+        }
+    }
+
+    DILProfileLines sorted;
+    for (auto &[where, samples] : lines)
+    {
+        sorted.emplace_back(samples, where);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+
+    return sorted;
+}
+
+void zone_type::addDILProfileSample(const std::string &stack)
+{
+    m_dil_stacks[stack]++;
+}
+
+std::string zone_type::getStatDILProfile(bool folded) const
+{
+    std::string msg;
+
+    if (folded)
+    {
+        for (auto &[stack, samples] : m_dil_stacks)
+        {
+            msg += diku::format_to_str("%s %u<br/>", stack.c_str(), samples);
+        }
+        return msg;
+    }
+
+    for (auto &[samples, where] : getDILProfileLines())
+    {
+        if (where.second)
+        {
+            msg += diku::format_to_str("%8u  %s:%u<br/>", samples, where.first.c_str(), where.second);
+        }
+        else
+        {
+            msg += diku::format_to_str("%8u  %s<br/>", samples, where.first.c_str());
+        }
+    }
+    return msg;
+}
+
+void zone_type::getStatDILProfileJSON(rapidjson::PrettyWriter<rapidjson::StringBuffer> &writer) const
+{
+    writer.StartObject();
+    {
+        json::write_kvp("seconds", (ubit64)(time(nullptr) - m_dil_profile_start), writer);
+        json::write_kvp("interval", DIL_PROFILE_INTERVAL, writer);
+
+        writer.String("lines");
+        writer.StartArray();
+        for (auto &[samples, where] : getDILProfileLines())
+        {
+            writer.StartObject();
+            json::write_kvp("program_name", where.first, writer);
+            json::write_kvp("line", where.second, writer);
+            json::write_kvp("samples", samples, writer);
+            writer.EndObject();
+        }
+        writer.EndArray();
+
+        writer.String("stacks");
+        writer.StartArray();
+        for (auto &[stack, samples] : m_dil_stacks)
+        {
+            writer.StartObject();
+            json::write_kvp("stack", stack, writer);
+            json::write_kvp("samples", samples, writer);
+            writer.EndObject();
+        }
+        writer.EndArray();
+    }
+    writer.EndObject();
+}
+
+void zone_type::resetDILProfile()
+{
+    auto reset = [](diltemplate *tmpl) {
+        tmpl->nSamples = 0;
+        if (tmpl->lineSamples)
+        {
+            memset(tmpl->lineSamples, 0, tmpl->nLines * sizeof(ubit32));
+        }
+    };
+
+    for (auto &[name, dil_template] : m_mmp_tmpl)
+    {
+        reset(dil_template.get());
+    }
+    for (auto &dil_template : m_retired_tmpl)
+    {
+        reset(dil_template.get());
+    }
+
+    m_dil_stacks.clear();
+    m_dil_profile_start = time(nullptr);
+}
+
+time_t zone_type::getDILProfileStart() const
+{
+    return m_dil_profile_start;
+}
+
+void zone_type::resolveTemplateReference(diltemplate *tmpl, int i)
+{
+    bool valid = true;
+    tmpl->extprg[i] = find_dil_template(tmpl->xrefs[i].name);
+
+    if (tmpl->extprg[i])
+    {
+        /* check argument count and types */
+        if ((tmpl->xrefs[i].rtnt != tmpl->extprg[i]->rtnt) || (tmpl->xrefs[i].argc != tmpl->extprg[i]->argc))
+        {
+            valid = false;
+        }
+        for (int j = 0; j < tmpl->xrefs[i].argc; j++)
+        {
+            if (tmpl->xrefs[i].argt[j] != tmpl->extprg[i]->argt[j])
+            {
+                valid = false;
+            }
+        }
+    }
+    else
+    {
+        /* ERROR MESSAGE HERE */
+        szonelog(this, "Cannot resolve external reference '%s'", tmpl->xrefs[i].name);
+    }
+    /* Typecheck error ! */
+    if (!valid)
+    {
+        tmpl->extprg[i] = nullptr;
+        /* ERROR MESSAGE HERE */
+        szonelog(this, "Error typechecking reference to '%s'", tmpl->xrefs[i].name);
+    }
+}
+
 void zone_type::resolveZoneTemplates()
 {
     for (auto &[name, tmpl] : m_mmp_tmpl)
@@ -478,35 +769,22 @@ void zone_type::resolveZoneTemplates()
         /* all external references */
         for (int i = 0; i < tmpl->xrefcount; i++)
         {
-            bool valid = true;
-            tmpl->extprg[i] = find_dil_template(tmpl->xrefs[i].name);
+            resolveTemplateReference(tmpl.get(), i);
+        }
+    }
+}
 
-            if (tmpl->extprg[i])
-            {
-                /* check argument count and types */
-                if ((tmpl->xrefs[i].rtnt != tmpl->extprg[i]->rtnt) || (tmpl->xrefs[i].argc != tmpl->extprg[i]->argc))
-                {
-                    valid = false;
-                }
-                for (int j = 0; j < tmpl->xrefs[i].argc; j++)
-                {
-                    if (tmpl->xrefs[i].argt[j] != tmpl->extprg[i]->argt[j])
-                    {
-                        valid = false;
-                    }
-                }
-            }
-            else
-            {
-                /* ERROR MESSAGE HERE */
-                szonelog(this, "Cannot resolve external reference '%s'", tmpl->xrefs[i].name);
-            }
-            /* Typecheck error ! */
-            if (!valid)
+void zone_type::rebindZoneTemplates(const zone_type *reloaded)
+{
+    for (auto &[name, tmpl] : m_mmp_tmpl)
+    {
+        for (int i = 0; i < tmpl->xrefcount; i++)
+        {
+            const char *zone = strchr(tmpl->xrefs[i].name, '@');
+
+            if (zone && str_ccmp(zone + 1, reloaded->getName().c_str()) == 0)
             {
-                tmpl->extprg[i] = nullptr;
-                /* ERROR MESSAGE HERE */
-                szonelog(this, "Error typechecking reference to '%s'", tmpl->xrefs[i].name);
+                resolveTemplateReference(tmpl.get(), i);
             }
         }
     }
@@ -517,6 +795,49 @@ void zone_type::insertDILTemplate(std::unique_ptr<diltemplate> &&value)
     m_mmp_tmpl.insert(std::make_pair(value->prgname, std::move(value)));
 }
 
+void zone_type::reindexDILTemplates(DILTemplateList &&templates)
+{
+    for (auto &[name, tmpl] : m_mmp_tmpl)
+    {
+        m_retired_tmpl.push_back(std::move(tmpl));
+    }
+    m_mmp_tmpl.clear();
+
+    for (auto &tmpl : templates)
+    {
+        insertDILTemplate(std::move(tmpl));
+    }
+}
+
+void zone_type::forEachDILTemplate(const std::function<void(diltemplate *)> &fn) const
+{
+    for (auto &[name, tmpl] : m_mmp_tmpl)
+    {
+        fn(tmpl.get());
+    }
+    for (auto &tmpl : m_retired_tmpl)
+    {
+        fn(tmpl.get());
+    }
+}
+
+size_t zone_type::freeRetiredDILTemplates(const std::set<const diltemplate *> &in_use)
+{
+    size_t before = m_retired_tmpl.size();
+
+    auto unused = std::remove_if(m_retired_tmpl.begin(), m_retired_tmpl.end(), [&in_use](const std::unique_ptr<diltemplate> &tmpl) {
+        if (in_use.count(tmpl.get()))
+        {
+            return false;
+        }
+        free_template_data(tmpl.get());
+        return true;
+    });
+    m_retired_tmpl.erase(unused, m_retired_tmpl.end());
+
+    return before - m_retired_tmpl.size();
+}
+
 diltemplate *zone_type::findDILTemplate(const std::string &name)
 {
     if (auto it = m_mmp_tmpl.find(name); it != m_mmp_tmpl.end())
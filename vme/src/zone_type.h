@@ -6,8 +6,13 @@
 #include "weather.h"
 
 #include <cstring>
+#include <ctime>
+#include <functional>
 #include <map>
 #include <memory>
+#include <set>
+#include <string>
+#include <vector>
 
 struct diltemplate;
 class unit_data;
@@ -20,6 +25,8 @@ class zone_type
 {
     using FileIndexMap = std::map<std::string, std::unique_ptr<file_index_type>>;
     using DILTemplateMap = std::map<std::string, std::unique_ptr<diltemplate>>;
+    using DILTemplateList = std::vector<std::unique_ptr<diltemplate>>;
+    using DILProfileLines = std::vector<std::pair<ubit32, std::pair<std::string, ubit32>>>;
 
     class PtrPtrType
     {
@@ -70,6 +77,10 @@ public:
 
     ubit32 getCrc() const;
     void setCrc(ubit32 crc);
+    /**
+     * Forget the CRC so a recompiled data file can be read, see reload_zone()
+     */
+    void clearCrc();
 
     /**
      * Extracted from extra_stat_zone()
@@ -86,10 +97,39 @@ public:
      */
     file_index_type *findFileIndex(const std::string &name);
 
+    /**
+     * Check that the file indexes of a recompiled data file can be merged into
+     * the zone, see reload_zone(). A unit can not change its type without a reboot.
+     * @param indexes The file indexes read from the new data file
+     * @return Why the indexes can not be merged, empty if they can
+     */
+    [[nodiscard]] std::string checkFileIndexes(const std::vector<std::unique_ptr<file_index_type>> &indexes) const;
+
+    /**
+     * Merge the file indexes of a recompiled data file into the zone, see reload_zone().
+     * Existing file indexes are updated in place so units and reset commands keep
+     * their pointers. Units no longer in the data file get a zero length, which
+     * read_unit() turns into slime. Rooms can only be updated, not added.
+     * The indexes must have passed checkFileIndexes().
+     * @param indexes The file indexes read from the new data file
+     */
+    void reindexFileIndexes(std::vector<std::unique_ptr<file_index_type>> &&indexes);
+
     [[nodiscard]] const zone_reset_cmd *cgetZoneResetCommands() const;
     zone_reset_cmd *getZoneResetCommands();
+    /**
+     * Replace the reset commands of the zone, the old ones are freed and a
+     * reset running through them is stopped.
+     */
     void setZoneResetCommands(zone_reset_cmd *value);
 
+    /**
+     * A reset is spread over several tics, this is the top level command
+     * it continues from on the next tic, or nullptr when no reset is running.
+     */
+    [[nodiscard]] zone_reset_cmd *getZoneResetNext() const;
+    void setZoneResetNext(zone_reset_cmd *value);
+
     [[nodiscard]] size_t getNumOfFileIndexes() const;
 
     [[nodiscard]] ubit16 getZoneResetTime() const;
@@ -106,6 +146,14 @@ public:
     [[nodiscard]] ubit16 getNumOfNPCs() const;
     void incrementNumOfNPCs();
 
+    /**
+     * Number of connected characters in the game and in the zone, kept up to
+     * date by descriptor_zone_update().
+     */
+    [[nodiscard]] ubit16 getNumOfPlayers() const;
+    void incrementNumOfPlayers();
+    void decrementNumOfPlayers();
+
     [[nodiscard]] ubit8 getResetMode() const;
     ubit8 *getResetModePtr();
     void setResetMode(ubit8 value);
@@ -158,11 +206,6 @@ public:
      */
     file_index_type *findOrCreatePlayerFileIndex(const char *name);
 
-    /**
-     * Extracted from zone_update_no_in_zone()
-     */
-    void updateNumberInZone();
-
     /**
      * Extracted from stat_dil()
      * @return std::string Formatted message
@@ -187,17 +230,68 @@ public:
      */
     void getStatGlobalDILJSON(ubit32 nCount, ubit64 &instructionSum, rapidjson::PrettyWriter<rapidjson::StringBuffer> &writer) const;
 
+    /**
+     * Record a sample of the DIL profiler, see dil_profile_sample()
+     * @param stack Folded call stack, outermost program first
+     */
+    void addDILProfileSample(const std::string &stack);
+
+    /**
+     * Profiler samples per DIL source line since the last reset
+     * @param folded List the sampled call stacks in folded format (flamegraph.pl) instead
+     * @return std::string Formatted message
+     */
+    [[nodiscard]] std::string getStatDILProfile(bool folded) const;
+
+    void getStatDILProfileJSON(rapidjson::PrettyWriter<rapidjson::StringBuffer> &writer) const;
+
+    /**
+     * Forget the DIL profiler samples of the zone and start a new window
+     */
+    void resetDILProfile();
+
+    /**
+     * @return time_t When the current DIL profiler window started
+     */
+    [[nodiscard]] time_t getDILProfileStart() const;
+
     /**
      * Extracted from resolve_templates()
      */
     void resolveZoneTemplates();
 
+    /**
+     * Resolve the external references of the zone's templates into a
+     * reloaded zone again, see reload_zone()
+     * @param reloaded The zone that was reloaded
+     */
+    void rebindZoneTemplates(const zone_type *reloaded);
+
     /**
      *
      * @param value Template to insert
      */
     void insertDILTemplate(std::unique_ptr<diltemplate> &&value);
 
+    /**
+     * Replace all DIL templates of the zone with the templates of a recompiled
+     * data file, see reload_zone(). The old templates are kept alive, unlisted,
+     * for the programs already running them.
+     * @param templates The templates read from the new data file
+     */
+    void reindexDILTemplates(DILTemplateList &&templates);
+
+    /**
+     * Calls 'fn' for every DIL template of the zone, the retired ones included
+     */
+    void forEachDILTemplate(const std::function<void(diltemplate *)> &fn) const;
+
+    /**
+     * Free the templates retired by reindexDILTemplates() which are not in 'in_use'
+     * @return Number of templates freed
+     */
+    size_t freeRetiredDILTemplates(const std::set<const diltemplate *> &in_use);
+
     /**
      * Extracted from find_dil_index()
      * Find template by name
@@ -210,7 +304,13 @@ public:
 
 private:
     unit_data *findFirstUnitOfType(int type);
+    void resolveTemplateReference(diltemplate *tmpl, int i);
     void diltemplateToJSON(diltemplate *dil_template, rapidjson::PrettyWriter<rapidjson::StringBuffer> &writer) const;
+    /**
+     * Profiler samples of the zone's templates per program and source line
+     * (0 when the template has no line table), most sampled first
+     */
+    [[nodiscard]] DILProfileLines getDILProfileLines() const;
 
     cNamelist m_creators;                     ///< List of creators of zone
     std::string m_name;                       ///< Unique in list
@@ -222,12 +322,15 @@ private:
     unit_data *m_npcs{nullptr};               ///< unit pointer to the base npcs, used in vmc really
     FileIndexMap m_mmp_fi;                    ///<
     zone_reset_cmd *m_zri{nullptr};           ///< List of Zone reset commands
+    zone_reset_cmd *m_zri_next{nullptr};      ///< Next top level command of a running reset
     DILTemplateMap m_mmp_tmpl;                ///<
+    DILTemplateList m_retired_tmpl;           ///< Templates replaced by a zone reload
     ubit8 **m_spmatrix{nullptr};              ///< Shortest Path Matrix
     ubit16 m_zone_time{0};                    ///< How often to reset zone
     ubit16 m_no_rooms{0};                     ///< The number of rooms
     ubit16 m_no_objs{0};                      ///<
     ubit16 m_no_npcs{0};                      ///<
+    ubit16 m_no_players{0};                   ///< Connected characters in the zone
     ubit8 m_reset_mode{0};                    ///< when/how to reset zone
     ubit8 m_access{255};                      ///< Access Level 0 = highest (root)
     ubit8 m_loadlevel{0};                     ///< Level required to load items
@@ -235,4 +338,6 @@ private:
     ubit32 m_crc{0};                          ///< The CRC for the zone (a timestamp, used to detect file changes mid game)
     std::optional<std::string> m_dilfilepath; ///<
     Weather m_weather;                        ///<
+    std::map<std::string, ubit32> m_dil_stacks; ///< Samples per folded DIL call stack
+    time_t m_dil_profile_start{time(nullptr)};  ///< Start of the DIL profiler window
 };